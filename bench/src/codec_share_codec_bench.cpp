@@ -0,0 +1,237 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "fixed.hpp"
+#include "receiver.hpp"
+#include "recoder.hpp"
+#include "stream.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// token of a type (default stamp when there is one, generated otherwise)
+static auto stamp(int64_t type) {
+    using namespace share::codec;
+    auto t = token::Type(type);
+    return token::DEFAULT.count(t) ? token::get(t) : token::generate(t, 1);
+}
+
+/// arguments (token type, k, frame size), generations limited to 64 MB
+static void arguments(benchmark::internal::Benchmark* b) {
+    using share::codec::token::Type;
+    b->ArgNames({"token", "k", "frame"});
+    for (auto type : {Type::SPARSE, Type::STREAM, Type::MESSAGE, Type::FULL})
+        for (int64_t k : {16, 64})
+            for (int64_t width : {64, 1024, 16384, 262144, 4194304})
+                if (k * width <= (int64_t{1} << 26))
+                    b->Args({int64_t(type), k, width});
+}
+
+/// rates (payload bytes and frames per second)
+static void set_counters(benchmark::State& state, size_t frames, size_t width) {
+    auto total = double(state.iterations() * frames);
+    state.SetBytesProcessed(int64_t(total * width));
+    state.counters["frames"] = benchmark::Counter(total, benchmark::Counter::kIsRate);
+}
+
+/// Encoder pop (k combinations of a generation)
+static void encoder_pop(benchmark::State& state) {
+    auto token   = stamp(state.range(0));
+    auto k       = size_t(state.range(1));
+    auto width   = size_t(state.range(2));
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    for (auto _ : state) {
+        auto coded = encoder.pop(k);
+        benchmark::DoNotOptimize(coded.data());
+        encoder.recycle(std::move(coded));
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(encoder_pop)->Apply(arguments)->Unit(benchmark::kMicrosecond);
+
+/// Decoder push and pop (a full generation)
+static void decoder_push_pop(benchmark::State& state) {
+    auto token   = stamp(state.range(0));
+    auto k       = size_t(state.range(1));
+    auto width   = size_t(state.range(2));
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto coded   = encoder.pop(4 * k);
+    auto decoder = share::codec::decoder<Vector>(k, token);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames = coded;
+        state.ResumeTiming();
+        for (auto& frame : frames) {
+            decoder.push(std::move(frame));
+            if (decoder.full())
+                break;
+        }
+        decoder.recycle(decoder.pop());
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(decoder_push_pop)->Apply(arguments)->Unit(benchmark::kMicrosecond);
+
+/// Recoder push and pop (a full generation relayed without decoding)
+static void recoder_push_pop(benchmark::State& state) {
+    auto token   = stamp(state.range(0));
+    auto k       = size_t(state.range(1));
+    auto width   = size_t(state.range(2));
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto coded   = encoder.pop(4 * k);
+    auto recoder = share::codec::recoder<Vector>(k, token);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames = coded;
+        state.ResumeTiming();
+        for (auto& frame : frames) {
+            recoder.push(std::move(frame));
+            if (recoder.full())
+                break;
+        }
+        recoder.recycle(recoder.pop(k));
+        recoder.clear();
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(recoder_push_pop)->Apply(arguments)->Unit(benchmark::kMicrosecond);
+
+/// Stream round trip (istream set and pop, ostream push and get of a message)
+static void stream_roundtrip(benchmark::State& state) {
+    auto token   = stamp(state.range(0));
+    auto k       = size_t(state.range(1));
+    auto width   = size_t(state.range(2));
+    auto message = generate(k * width - 8, 1).front();
+    for (auto _ : state) {
+        auto in  = share::codec::istream<Vector>(token);
+        auto out = share::codec::ostream<Vector>(k + 2, token);
+        auto n   = in.set(message, uint32_t(width + sizeof(uint32_t)), 4);
+        // sparse tokens may need more than the redundancy
+        for (size_t i = 0; i < 4 * n; ++i)
+            if (out.push(in.pop()))
+                break;
+        if (out.get().size() != message.size()) {
+            state.SkipWithError("message not decoded");
+            break;
+        }
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(stream_roundtrip)->Apply(arguments)->Unit(benchmark::kMicrosecond);
+
+/// coded frames of a message of k frames (no redundancy, so a message decodes exactly once)
+static auto message(size_t k, size_t width) {
+    auto in    = share::codec::istream<Vector>();
+    auto n     = in.set(generate(k * width - 8, 1).front(), uint32_t(width + sizeof(uint32_t)));
+    auto coded = std::vector<Vector>();
+    for (size_t i = 0; i < n; ++i)
+        coded.push_back(in.pop());
+    return coded;
+}
+
+/// receive path of a synchronous ostream (the push decodes on the receive thread)
+static void ostream_push(benchmark::State& state) {
+    auto k     = size_t(state.range(0));
+    auto width = size_t(state.range(1));
+    auto coded = message(k, width);
+    auto out   = share::codec::ostream<Vector>(k);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames = coded;
+        state.ResumeTiming();
+        for (auto& frame : frames)
+            out.push(std::move(frame));
+        state.PauseTiming();
+        benchmark::DoNotOptimize(out.get());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * coded.size()));
+}
+BENCHMARK(ostream_push)
+  ->ArgsProduct({{16, 64}, {1024, 16384, 262144}})
+  ->Iterations(64)
+  ->Unit(benchmark::kMicrosecond);
+
+/// receive path of a receiver (the push only enqueues, the worker decodes), fixed iterations
+/// as each one waits untimed for the worker
+static void receiver_push(benchmark::State& state) {
+    auto k     = size_t(state.range(0));
+    auto width = size_t(state.range(1));
+    auto coded = message(k, width);
+    auto token = share::codec::token::get(share::codec::token::Type::FULL);
+    auto done  = std::atomic<size_t>{0};
+    auto rx    = share::codec::receiver<Vector>(
+      [&done](Vector) { done.fetch_add(1); }, k, token, 2 * coded.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames = coded;
+        auto target = done.load() + 1;
+        state.ResumeTiming();
+        for (auto& frame : frames)
+            rx.push(std::move(frame));
+        state.PauseTiming();
+        auto limit = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (done.load() < target && std::chrono::steady_clock::now() < limit)
+            std::this_thread::yield();
+        if (done.load() < target)
+            state.SkipWithError("message not decoded");
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * coded.size()));
+}
+BENCHMARK(receiver_push)
+  ->ArgsProduct({{16, 64}, {1024, 16384, 262144}})
+  ->Iterations(64)
+  ->Unit(benchmark::kMicrosecond);
+
+/// frame round trip of a dynamic codec (encode and decode one frame at a time, a generation)
+static void dynamic_roundtrip(benchmark::State& state) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto decoder = share::codec::decoder<Vector>(k, token);
+    for (auto _ : state) {
+        while (!decoder.full())
+            decoder.push(encoder.pop(1));
+        decoder.recycle(decoder.pop());
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(dynamic_roundtrip)
+  ->ArgsProduct({{16, 32}, {64, 256, 1024}})
+  ->Unit(benchmark::kMicrosecond);
+
+/// frame round trip of a fixed codec (same sizes as dynamic_roundtrip)
+template <size_t K, size_t N>
+static void fixed_roundtrip(benchmark::State& state) {
+    auto encoder = std::make_unique<share::codec::fixed::encoder<K, N>>();
+    auto decoder = std::make_unique<share::codec::fixed::decoder<K, N>>();
+    for (auto& frame : generate(N, K))
+        encoder->push(frame.data());
+    auto frame = typename share::codec::fixed::encoder<K, N>::Frame{};
+    for (auto _ : state) {
+        while (!decoder->full()) {
+            encoder->pop(frame);
+            decoder->push(frame);
+        }
+        benchmark::DoNotOptimize(decoder->at(0).data());
+        decoder->clear();
+    }
+    set_counters(state, K, N);
+}
+BENCHMARK_TEMPLATE(fixed_roundtrip, 16, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(fixed_roundtrip, 16, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(fixed_roundtrip, 16, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(fixed_roundtrip, 32, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(fixed_roundtrip, 32, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(fixed_roundtrip, 32, 1024)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "helpers/copy.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// coded frames of a generation (k, width)
+static auto encode(size_t k, size_t width, share::codec::token::shared::Stamp token) {
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    return encoder.pop(k);
+}
+
+/// per frame latency
+static void set_counters(benchmark::State& state, size_t k, size_t width) {
+    auto frames             = double(state.iterations() * k);
+    state.counters["frame"] = benchmark::Counter(
+      frames, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.SetBytesProcessed(int64_t(frames * width));
+}
+
+/// Decoder push (one frame per push, incremental elimination)
+using Mode = share::codec::decoder<Vector>::Mode;
+static void decoder_push(benchmark::State& state, Mode mode) {
+    auto k     = size_t(state.range(0));
+    auto width = size_t(state.range(1));
+    auto token = share::codec::token::get(share::codec::token::Type::FULL);
+    auto coded = encode(k, width, token);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames  = coded;
+        auto decoder = share::codec::decoder<Vector>(k, token, mode);
+        state.ResumeTiming();
+        for (auto& frame : frames)
+            decoder.push(std::move(frame));
+        benchmark::DoNotOptimize(decoder.size());
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK_CAPTURE(decoder_push, eager, Mode::EAGER)
+  ->ArgsProduct({{50, 100, 250}, {1024, 65536}})
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(decoder_push, deferred, Mode::DEFERRED)
+  ->ArgsProduct({{50, 100, 250}, {1024, 65536}})
+  ->Unit(benchmark::kMillisecond);
+
+/// Full solve on every push (reference)
+static void decoder_resolve(benchmark::State& state) {
+    using namespace share::codec;
+    auto k     = size_t(state.range(0));
+    auto width = size_t(state.range(1));
+    auto token = token::get(token::Type::FULL);
+    auto coded = encode(k, width, token);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames = coded;
+        auto coef   = container<Vector>();
+        auto data   = container<Vector>();
+        auto field  = Vector();
+        state.ResumeTiming();
+        for (auto& frame : frames) {
+            auto seed = uint32_t{0};
+            helpers::copy(std::prev(std::end(frame), sizeof(seed)), seed);
+            frame.resize(width);
+            auto row = Vector(k + sizeof(int));
+            helpers::coefficients<std::minstd_rand0>(
+              seed, (*token)[uint8_t(seed)].first, (*token)[uint8_t(seed)].second, row);
+            coef.push_back(std::move(row));
+            data.push_back(std::move(frame));
+            field.push_back((*token)[uint8_t(seed)].first);
+            benchmark::DoNotOptimize(helpers::solve(k, field, coef, data));
+        }
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(decoder_resolve)->ArgsProduct({{50, 100, 250}, {1024}})->Unit(benchmark::kMillisecond);
+
+/// Decoder push of sparse tokens (dense elimination against sparse elimination)
+static void decoder_sparse(benchmark::State& state, Mode mode) {
+    using namespace share::codec;
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto token   = token::generate(token::Type(state.range(2)), 1);
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto coded   = encoder.pop(2 * k);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames  = coded;
+        auto decoder = share::codec::decoder<Vector>(k, token, mode);
+        state.ResumeTiming();
+        for (auto& frame : frames) {
+            decoder.push(std::move(frame));
+            if (decoder.full())
+                break;
+        }
+        if (!decoder.full())
+            state.SkipWithError("rank deficient");
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK_CAPTURE(decoder_sparse, eager, Mode::EAGER)
+  ->ArgsProduct({{100, 500, 1000}, {1024}, {int64_t(share::codec::token::Type::SPARSE),
+                                            int64_t(share::codec::token::Type::STREAM)}})
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(decoder_sparse, sparse, Mode::SPARSE)
+  ->ArgsProduct({{100, 500, 1000}, {1024}, {int64_t(share::codec::token::Type::SPARSE),
+                                            int64_t(share::codec::token::Type::STREAM)}})
+  ->Unit(benchmark::kMillisecond);
+
+/// Decoder push of a binary token (bit packed elimination) against a GF(2^8) token
+static void decoder_binary(benchmark::State& state) {
+    using namespace share::codec;
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto field   = uint8_t(state.range(2));
+    auto token   = std::make_shared<const token::Stamp>(256, token::Density{field, 127});
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto coded   = encoder.pop(2 * k);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames  = coded;
+        auto decoder = share::codec::decoder<Vector>(k, token);
+        state.ResumeTiming();
+        for (auto& frame : frames) {
+            decoder.push(std::move(frame));
+            if (decoder.full())
+                break;
+        }
+        if (!decoder.full())
+            state.SkipWithError("rank deficient");
+    }
+    set_counters(state, k, width);
+}
+BENCHMARK(decoder_binary)
+  ->ArgsProduct({{100, 500, 1000}, {1024}, {1, 255}})
+  ->Unit(benchmark::kMillisecond);
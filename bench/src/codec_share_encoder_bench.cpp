@@ -0,0 +1,27 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "encoder.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// Encoder pop (column striped combinations over a number of threads)
+static void encoder_parallel(benchmark::State& state) {
+    using namespace share::codec;
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto threads = size_t(state.range(2));
+    auto workers = helpers::parallel(threads);
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token::get(token::Type::FULL));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(encoder.pop(k, workers));
+    state.SetBytesProcessed(int64_t(state.iterations() * k * width));
+}
+BENCHMARK(encoder_parallel)
+  ->ArgsProduct({{50}, {1000000}, {1, 2, 4, 8, 16}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "helpers/combine.hpp"
+#include "helpers/gf8.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// region sizes (64 B to 4 MB)
+static void regions(benchmark::internal::Benchmark* b) {
+    for (auto width : {64, 512, 4096, 32768, 262144, 2097152, 4194304})
+        b->Arg(width);
+}
+
+/// Region multiply (a *= m)
+static void gf8_mul(benchmark::State& state) {
+    using namespace share::codec::helpers;
+    auto width = size_t(state.range(0));
+    auto data  = generate(width, 1);
+    for (auto _ : state) {
+        gf8::mul(data[0].data(), width, uint8_t(0x53));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * width));
+}
+BENCHMARK(gf8_mul)->Apply(regions);
+
+/// Region sum (a += b)
+static void gf8_sum(benchmark::State& state) {
+    using namespace share::codec::helpers;
+    auto width = size_t(state.range(0));
+    auto data  = generate(width, 2);
+    for (auto _ : state) {
+        gf8::sum(data[0], data[1]);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * width));
+}
+BENCHMARK(gf8_sum)->Apply(regions);
+
+/// Region fused multiply add (a += b * m)
+static void gf8_muladd(benchmark::State& state) {
+    using namespace share::codec::helpers;
+    auto width = size_t(state.range(0));
+    auto data  = generate(width, 2);
+    for (auto _ : state) {
+        gf8::muladd(data[0].data(), data[1].data(), width, uint8_t(0x53));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * width));
+}
+BENCHMARK(gf8_muladd)->Apply(regions);
+
+/// Blocked combination (k outputs of k inputs, input bytes per second)
+static void helpers_combine(benchmark::State& state) {
+    using namespace share::codec::helpers;
+    auto k      = size_t(state.range(0));
+    auto width  = size_t(state.range(1));
+    auto input  = generate(width, k);
+    auto coef   = generate(k, k);
+    auto output = generate(width, k);
+    for (auto _ : state) {
+        combine(input, coef, output);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * k * width));
+    state.counters["frame"] = benchmark::Counter(
+      double(state.iterations() * k), benchmark::Counter::kIsRate);
+}
+BENCHMARK(helpers_combine)
+  ->ArgsProduct({{16, 64}, {64, 1024, 16384, 262144}})
+  ->Unit(benchmark::kMicrosecond);
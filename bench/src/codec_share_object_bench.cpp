@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "object.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// Object round trip (throughput should not depend on the object size)
+///   - size    : object size (MB)
+///   - k       : frames per generation
+///   - batch   : generations coded per parallel batch
+static void object_roundtrip(benchmark::State& state) {
+    using namespace share::codec;
+    auto size    = size_t(state.range(0)) << 20;
+    auto k       = size_t(state.range(1));
+    auto batch   = size_t(state.range(2));
+    auto workers = std::make_shared<helpers::parallel>(std::thread::hardware_concurrency());
+    auto gen     = std::mt19937{1};
+    auto data    = Vector(size);
+    std::generate(std::begin(data), std::end(data), [&gen]() { return uint8_t(gen()); });
+
+    auto token  = token::get(token::Type::FULL);
+    auto layout = object::layout{size, k, 1024};
+    for (auto _ : state) {
+        auto encoder = object::encoder<Vector>(data, layout, token, workers);
+        auto decoder = object::decoder<Vector>(layout, token, workers);
+        for (size_t g = 0; g < encoder.generations(); g += batch) {
+            auto frames = object::decoder<Vector>::Container();
+            for (auto& coded : encoder.pop(g, batch, 0))
+                for (auto& frame : coded)
+                    frames.push_back(std::move(frame));
+            decoder.push(std::move(frames));
+        }
+        benchmark::DoNotOptimize(decoder.data().data());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * size));
+}
+BENCHMARK(object_roundtrip)
+  ->ArgsProduct({{4, 16, 64}, {32, 128}, {8}})
+  ->Unit(benchmark::kMillisecond);
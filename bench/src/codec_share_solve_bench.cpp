@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "helpers/copy.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// Solve (column striped payload over a number of threads)
+static void solve_parallel(benchmark::State& state) {
+    using namespace share::codec;
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto threads = size_t(state.range(2));
+    auto token   = token::get(token::Type::FULL);
+    auto workers = helpers::parallel(threads);
+    // coded system
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto field   = Vector();
+    auto coef    = container<Vector>();
+    auto data    = container<Vector>();
+    for (auto& frame : encoder.pop(k)) {
+        auto seed = uint32_t{0};
+        helpers::copy(std::prev(std::end(frame), sizeof(seed)), seed);
+        frame.resize(width);
+        auto row = Vector(k);
+        helpers::coefficients<std::minstd_rand0>(
+          seed, (*token)[uint8_t(seed)].first, (*token)[uint8_t(seed)].second, row);
+        field.push_back((*token)[uint8_t(seed)].first);
+        coef.push_back(std::move(row));
+        data.push_back(std::move(frame));
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto f = field;
+        auto c = coef;
+        auto d = data;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(helpers::solve(k, f, c, d, workers));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * k * width));
+}
+BENCHMARK(solve_parallel)
+  ->ArgsProduct({{50}, {1000000}, {1, 2, 4, 8, 16}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+/// Decoder push (column striped payload over a number of threads)
+static void decoder_parallel(benchmark::State& state) {
+    using namespace share::codec;
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto threads = size_t(state.range(2));
+    auto token   = token::get(token::Type::FULL);
+    auto workers = std::make_shared<helpers::parallel>(threads);
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto coded   = encoder.pop(k);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames  = coded;
+        auto decoder = share::codec::decoder<Vector>(
+          k, token, share::codec::decoder<Vector>::Mode::EAGER, workers);
+        state.ResumeTiming();
+        for (auto& frame : frames)
+            decoder.push(std::move(frame));
+        benchmark::DoNotOptimize(decoder.size());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * k * width));
+}
+BENCHMARK(decoder_parallel)
+  ->ArgsProduct({{50}, {1000000}, {1, 2, 4, 8, 16}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+/// Program replay (payload row operations only, column striped over a number of threads)
+static void program_parallel(benchmark::State& state) {
+    using namespace share::codec;
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto threads = size_t(state.range(2));
+    auto workers = helpers::parallel(threads);
+    auto data    = generate(width, k);
+    // elimination like program (k x k row operations)
+    auto prog = helpers::program();
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < k; ++j)
+            if (i != j)
+                prog.muladd(i, j, uint8_t(1 + (i * k + j) % 255));
+    for (auto _ : state) {
+        workers.run(width, prog.size() * width, [&](size_t offset, size_t length) {
+            prog.run(data, offset, length);
+        });
+        benchmark::DoNotOptimize(data.front().data());
+    }
+    state.counters["threads"] = double(workers.threads());
+    state.SetBytesProcessed(int64_t(state.iterations() * prog.size() * width));
+}
+BENCHMARK(program_parallel)
+  ->ArgsProduct({{50}, {1000000}, {1, 2, 4, 8, 16}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+
+#include "codec_share_fixture.hpp"
+
+/// built twice, in codec-share-bench (stats off) and codec-share-stats-bench (stats on),
+/// the overhead of the instrumentation is the ratio of the same benchmark in both reports
+using Vector = std::vector<uint8_t>;
+using Mode   = share::codec::decoder<Vector>::Mode;
+
+#ifdef CODEC_SHARE_STATS
+static constexpr auto STATS = "stats on";
+#else
+static constexpr auto STATS = "stats off";
+#endif
+
+/// Decoder push (small frames, the per frame cost of the instrumentation dominates)
+static void stats_decoder_push(benchmark::State& state, Mode mode) {
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    auto coded   = encoder.pop(k + 2);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto frames  = coded;
+        auto decoder = share::codec::decoder<Vector>(k, token, mode);
+        state.ResumeTiming();
+        for (auto& frame : frames)
+            decoder.push(std::move(frame));
+        benchmark::DoNotOptimize(decoder.size());
+    }
+    state.SetLabel(STATS);
+    state.SetBytesProcessed(int64_t(state.iterations() * coded.size() * width));
+}
+BENCHMARK_CAPTURE(stats_decoder_push, eager, Mode::EAGER)
+  ->ArgsProduct({{16, 64}, {64, 1024}})
+  ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(stats_decoder_push, deferred, Mode::DEFERRED)
+  ->ArgsProduct({{16, 64}, {64, 1024}})
+  ->Unit(benchmark::kMicrosecond);
+
+/// Encoder pop (one frame per pop)
+static void stats_encoder_pop(benchmark::State& state) {
+    auto k       = size_t(state.range(0));
+    auto width   = size_t(state.range(1));
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto encoder = share::codec::encoder<Vector>(generate(width, k), token);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(encoder.pop(1));
+    state.SetLabel(STATS);
+    state.SetBytesProcessed(int64_t(state.iterations() * width));
+}
+BENCHMARK(stats_encoder_pop)->ArgsProduct({{16, 64}, {64, 1024}});
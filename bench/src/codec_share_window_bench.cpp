@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "window.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+/// Sliding window stream over a lossy link (in order delivery latency in frame slots)
+///   - span    : window frames
+///   - loss    : loss rate (per mille)
+///   - repair  : one combination every repair source frames
+static void window_stream(benchmark::State& state) {
+    using namespace share::codec;
+    auto span   = size_t(state.range(0));
+    auto loss   = std::bernoulli_distribution{double(state.range(1)) / 1000};
+    auto repair = size_t(state.range(2));
+    auto frames = size_t{2000};
+    auto width  = size_t{1024};
+    auto gen    = std::mt19937{1};
+    auto source = Vector(width);
+    std::generate(std::begin(source), std::end(source), [&gen]() { return uint8_t(gen()); });
+
+    auto delay     = size_t{0};
+    auto delivered = size_t{0};
+    auto lost      = size_t{0};
+    for (auto _ : state) {
+        auto encoder = window::encoder<Vector>(span, width);
+        auto decoder = window::decoder<Vector>(span, width);
+        for (size_t n = 0; n < frames; ++n) {
+            auto index = encoder.push(source);
+            if (!loss(gen))
+                decoder.push(encoder.systematic(index));
+            if ((n + 1) % repair == 0 && !loss(gen))
+                decoder.push(encoder.pop());
+            // frame i is delivered at slot n
+            for (; decoder.ready(); ++delivered) {
+                benchmark::DoNotOptimize(decoder.pop());
+                delay += n - (decoder.next() - decoder.ready() - 1);
+            }
+            encoder.ack(decoder.next());
+        }
+        lost += decoder.lost();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations() * frames * width));
+    state.counters["delay"] = delivered ? double(delay) / double(delivered) : 0.0;
+    state.counters["lost"]  = double(lost) / double(state.iterations() * frames);
+}
+BENCHMARK(window_stream)
+  ->ArgsProduct({{8, 32}, {0, 10, 50}, {2, 4}})
+  ->Unit(benchmark::kMillisecond);
@@ -7,8 +7,22 @@
 
 #pragma once
 
+#include <algorithm>
+#include <numeric>
+#include <random>
+
 #include "container.hpp"
+#include "pool.hpp"
+#include "seed.hpp"
+#include "helpers/binary.hpp"
+#include "helpers/cache.hpp"
+#include "helpers/combine.hpp"
+#include "helpers/matrix.hpp"
+#include "helpers/parallel.hpp"
+#include "helpers/program.hpp"
 #include "helpers/solve.hpp"
+#include "helpers/sparse.hpp"
+#include "helpers/stats.hpp"
 #include "token.hpp"
 
 namespace share::codec {
@@ -19,13 +33,33 @@ using Generator = std::minstd_rand0;
 
 /// decoder
 /// @brief
-template <typename Vector>
+/// the Generator must match the one of the encoder (e.g. helpers::counter on both sides)
+template <typename Vector, typename Generator = std::minstd_rand0>
 class decoder {
   public:
     // helpers
     using Container = container<Vector>;
     using Value     = typename Vector::value_type;
 
+    /// decoding modes
+    /// - EAGER    : payload rows are reduced together with the coefficients (bit packed
+    ///              basis and plain payload sums when every field of the token is 1), with
+    ///              binary and GF(2^8) fields mixed the payload rows are solved at full rank,
+    ///              binary rows first (see helpers::solve)
+    /// - DEFERRED : only coefficients are reduced, payload rows are combined once when needed
+    /// - SPARSE   : compressed coefficient rows with fill-in minimizing pivots, payload rows
+    ///              are solved at full rank (SPARSE and STREAM tokens, see helpers::sparse)
+    enum class Mode { EAGER, DEFERRED, SPARSE };
+
+    /// shared workers (payload processed over column stripes)
+    using Parallel = std::shared_ptr<helpers::parallel>;
+
+    /// shared frame pool
+    using Pool = std::shared_ptr<codec::pool<Vector>>;
+
+    /// shared coefficient cache
+    using Cache = std::shared_ptr<helpers::cache>;
+
     /// empty constructor
     decoder() = default;
 
@@ -35,19 +69,58 @@ class decoder {
     /// constructor
     /// @param capacity
     /// @param token
-    decoder(size_t capacity, token::shared::Stamp token = token::get(token::Type::FULL))
-      : data_{}, coef_{}, field_{}, capacity_{capacity}, size_{}, token_{token} {
-        coef_.reserve(capacity << 1);
-        data_.reserve(capacity << 1);
-        field_.reserve(capacity << 1);
+    /// @param mode
+    /// @param parallel
+    decoder(
+      size_t capacity,
+      token::shared::Stamp token = token::get(token::Type::FULL),
+      Mode mode                  = Mode::EAGER,
+      Parallel parallel          = {})
+      : data_{},
+        coef_{0,
+              (mode == Mode::DEFERRED) ? 2 * capacity : capacity,
+              (mode == Mode::SPARSE || (mode == Mode::EAGER && binary(token))) ? 0 : capacity + 1},
+        sparse_{(mode == Mode::SPARSE) ? capacity : 0},
+        binary_{(mode == Mode::EAGER && binary(token)) ? capacity : 0},
+        row_{},
+        raw_{},
+        rows_{},
+        field_{},
+        pivots_{},
+        dirty_{},
+        program_{},
+        pending_{},
+        tail_{},
+        out_{},
+        capacity_{capacity},
+        size_{},
+        token_{token},
+        mode_{mode},
+        mixed_{mode == Mode::EAGER && mixed(token)},
+        parallel_{std::move(parallel)} {
+        data_.reserve(capacity + 1);
+        pivots_.reserve(capacity);
+        if (mode_ == Mode::DEFERRED)
+            raw_.reserve(capacity);
+        if (mixed_) {
+            rows_.reserve(capacity);
+            field_.reserve(capacity);
+        }
     }
 
     /// constructor
     /// @param capacity
     /// @param init
     /// @param token
-    decoder(size_t capacity, Container init, token::shared::Stamp token)
-      : decoder(capacity, token) {
+    /// @param mode
+    /// @param parallel
+    decoder(
+      size_t capacity,
+      Container init,
+      token::shared::Stamp token,
+      Mode mode         = Mode::EAGER,
+      Parallel parallel = {})
+      : decoder(capacity, token, mode, std::move(parallel)) {
         push(std::move(init));
     }
 
@@ -63,21 +136,30 @@ class decoder {
     decoder& operator=(decoder&&) = default;
 
     /// push
+    /// @brief payloads that do not increase the rank are dropped (back to the pool),
+    ///        so at most capacity payload rows are held
     /// @param data
-    void push(Container data);
+    /// @return number of innovative frames
+    size_t push(Container data);
 
     /// push
     /// @param data
-    void push(Vector data) { push(Container{std::move(data)}); }
+    /// @return true when the frame is innovative
+    bool push(Vector data) {
+        auto frames = pool_->container();
+        frames.push_back(std::move(data));
+        return push(std::move(frames)) != 0;
+    }
 
     /// pop
-    /// @return decoded frames
+    /// @return decoded frames (the caches are kept for the next generation)
     Container pop() {
-        data_.resize(size_);
-        size_ = 0;
-        coef_.clear();
-        field_.clear();
-        return std::move(data_);
+        materialize(0, size_);
+        auto out = pool_->container();
+        for (size_t i = 0; i < size_; ++i)
+            out.push_back(std::move(data_[i]));
+        clear();
+        return out;
     }
 
     /// Clear data
@@ -85,23 +167,52 @@ class decoder {
     void clear() {
         size_ = 0;
         coef_.clear();
-        data_.clear();
+        drain(data_);
+        drain(raw_);
+        drain(rows_);
         field_.clear();
+        pivots_.clear();
+        dirty_.clear();
+        sparse_.clear();
+        binary_.clear();
     }
 
+    /// pool
+    /// @brief frames are recycled through the pool (may be shared with encoders)
+    /// @param pool
+    void pool(Pool pool) { pool_ = std::move(pool); }
+    auto& pool() const { return pool_; }
+
+    /// recycle
+    /// @brief hand consumed decoded frames back to the pool
+    /// @param frames
+    void recycle(Container frames) { pool_->recycle(std::move(frames)); }
+
+    /// cache
+    /// @brief coefficient rows of repeated seeds are copied from the cache
+    /// @param cache
+    void cache(Cache cache) { cache_ = std::move(cache); }
+    auto& cache() const { return cache_; }
+
+#ifdef CODEC_SHARE_STATS
+    /// stats
+    /// @brief counters and phase timings (builds with CODEC_SHARE_STATS)
+    auto& stats() const { return stats_; }
+#endif
+
     /// Iterators
     /// forward
-    auto begin() const { return std::begin(data_); }
+    auto begin() const { return std::begin(materialize(0, size_)); }
     auto end() const { return std::next(std::begin(data_), size_); }
 
     /// backward
-    auto rbegin() const { return std::prev(std::rend(data_), size_); }
+    auto rbegin() const { return std::prev(std::rend(materialize(0, size_)), size_); }
     auto rend() const { return std::rend(data_); }
 
     /// references
-    auto& front() const { return data_.front(); }
-    auto& at(size_t n) const { return data_.at(n); }
-    auto& back() const { return data_.at(size_ - 1); }
+    auto& front() const { return materialize(0, 1).front(); }
+    auto& at(size_t n) const { return materialize(n, n + 1).at(n); }
+    auto& back() const { return materialize(size_ - 1, size_).at(size_ - 1); }
 
     /// quantity
     auto full() { return (size_ >= capacity_); }
@@ -109,18 +220,52 @@ class decoder {
     auto size() { return size_; }
     auto capacity() { return capacity_; }
     void resize(size_t size) {
+        materialize(0, std::min(size, size_));
         data_.resize(size);
         coef_.resize(size);
-        field_.resize(size);
+        pivots_.resize(std::min(size, pivots_.size()));
+        dirty_.resize(std::min(size, dirty_.size()));
         if (size_ > size)
             size_ = size;
     }
 
+    /// memory
+    /// @return bytes held (frames, coefficient slab and caches, the pool excluded)
+    size_t memory() const {
+        auto bytes = coef_.memory() + sparse_.memory() + binary_.memory() + row_.capacity()
+                     + field_.capacity() + (pivots_.capacity() + pending_.capacity()) * sizeof(size_t);
+        for (auto& frame : data_)
+            bytes += frame.capacity() * sizeof(Value);
+        for (auto& frame : raw_)
+            bytes += frame.capacity() * sizeof(Value);
+        for (auto& frame : rows_)
+            bytes += frame.capacity() * sizeof(Value);
+        return bytes;
+    }
+
   private:
-    /// Cache
-    Container data_;
-    Container coef_;
-    std::vector<Value> field_;
+    /// Cache (reduced echelon basis, the coefficient rows share one aligned slab)
+    mutable Container data_;
+    helpers::matrix coef_;
+    /// Cache (sparse mode: compressed echelon basis)
+    helpers::sparse sparse_;
+    /// Cache (binary token: bit packed reduced echelon basis)
+    helpers::binary binary_;
+    /// Cache (coefficients of the frame being pushed)
+    Vector row_;
+    /// Cache (deferred mode: received payload and rows not yet combined)
+    Container raw_;
+    /// Cache (mixed token: received coefficient rows and their fields)
+    Container rows_;
+    std::vector<uint8_t> field_;
+    std::vector<size_t> pivots_;
+    mutable std::vector<bool> dirty_;
+    /// Cache (payload operations of a push)
+    helpers::program program_;
+    /// Cache (deferred mode: rows, coefficients and outputs of a combination)
+    mutable std::vector<size_t> pending_;
+    mutable std::vector<const uint8_t*> tail_;
+    mutable std::vector<helpers::row> out_;
 
     /// Context
     size_t capacity_;
@@ -128,14 +273,93 @@ class decoder {
 
     /// Property
     token::shared::Stamp token_;
+    Mode mode_;
+    bool mixed_;
+    Parallel parallel_;
+    Pool pool_ = std::make_shared<codec::pool<Vector>>();
+    Cache cache_;
+#ifdef CODEC_SHARE_STATS
+    mutable helpers::stats stats_;
+#endif
+
+    /// binary
+    /// @brief every field of the token is 1 (0 / 1 coefficients)
+    static bool binary(const token::shared::Stamp& token) {
+        return token && std::all_of(std::begin(*token), std::end(*token), [](auto& density) {
+                   return density.first <= 1;
+               });
+    }
+
+    /// mixed
+    /// @brief the token has binary fields (1) and GF(2^8) fields
+    static bool mixed(const token::shared::Stamp& token) {
+        auto small = [](auto& density) { return density.first <= 1; };
+        return token && std::any_of(std::begin(*token), std::end(*token), small)
+               && !std::all_of(std::begin(*token), std::end(*token), small);
+    }
+
+    /// drain
+    /// @brief hand the frames back to the pool (container capacity kept)
+    void drain(Container& frames) {
+        for (auto& frame : frames)
+            pool_->recycle(std::move(frame));
+        frames.clear();
+    }
+
+    /// stripes
+    /// @brief run function(offset, length) over the payload columns
+    template <typename Function>
+    void stripes(size_t length, size_t workload, Function&& function) const {
+        if (parallel_)
+            parallel_->run(length, workload, std::forward<Function>(function));
+        else
+            function(size_t{0}, length);
+    }
+
+    /// run
+    /// @brief replay payload operations over the column stripes
+    void run(const helpers::program& program) {
+        auto length = data_.length();
+        CODEC_SHARE_PHASE(&stats_, PAYLOAD);
+        CODEC_SHARE_COUNT(&stats_, BYTES, program.size() * length);
+        stripes(length, program.size() * length, [this, &program](size_t offset, size_t len) {
+            program.run(data_, offset, len);
+        });
+    }
+
+    /// solve
+    /// @brief back substitution of the sparse basis, or binary first solve of the received
+    ///        rows (mixed token), at full rank (rows to pivot order)
+    void solve() {
+        if (mixed_) {
+            if (parallel_)
+                helpers::solve(capacity_, field_, rows_, data_, *parallel_);
+            else
+                helpers::solve(capacity_, field_, rows_, data_);
+        } else {
+            program_.clear();
+            sparse_.solve(program_);
+            run(program_);
+            sparse_.permute(data_);
+        }
+        pivots_.resize(capacity_);
+        std::iota(std::begin(pivots_), std::end(pivots_), size_t{0});
+    }
+
+    /// materialize
+    /// @brief combine the payload of the basis rows [first, last) (deferred mode)
+    const Container& materialize(size_t first, size_t last) const;
 };
 
 
 /// push
 /// @param data
-template <typename Vector>
-void decoder<Vector>::push(Container data) {
+template <typename Vector, typename Generator>
+size_t decoder<Vector, Generator>::push(Container data) {
+    CODEC_SHARE_BIND(&stats_);
+    auto innovative = size_t{0};
     for (auto& frame : data) {
+        CODEC_SHARE_COUNT(&stats_, FRAMES, 1);
         // remove seed
         auto seed = uint32_t(frame.back());
         frame.pop_back();
@@ -148,22 +372,168 @@ void decoder<Vector>::push(Container data) {
         seed <<= 8;
         seed |= uint32_t(frame.back());
         frame.pop_back();
-        // properties
-        auto field     = uint8_t{(*token_)[uint8_t(seed)].first};
-        auto sparsity  = uint8_t{(*token_)[uint8_t(seed)].second};
-        auto generator = Generator{seed};
+        // full rank, nothing left to decode
+        if (pivots_.size() >= capacity_) {
+            CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
+            continue;
+        }
         // gerenate coefficients
-        auto coef = Vector(capacity_ + sizeof(int));
-        for (auto& val : coef) {
-            auto factor = Value(generator());
-            if (factor > sparsity)
+        row_.assign(coef_.cols(), 0);
+        auto coef = helpers::row(row_.data(), capacity_);
+        if (seed::recoded(seed)) {
+            // recoded frame (explicit coefficients before the seed)
+            if (frame.size() < capacity_) {
+                CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
                 continue;
-            val = (factor & field);
+            }
+            std::copy(std::prev(std::end(frame), capacity_), std::end(frame), coef.data());
+            frame.resize(frame.size() - capacity_);
+        } else if (seed::reserved(seed)) {
+            // systematic frame (identity row)
+            if (seed::index(seed) >= capacity_) {
+                CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
+                continue;
+            }
+            coef[seed::index(seed)] = 1;
+        } else if (!cache_ || !cache_->find<Generator>(seed, token_, capacity_, coef.data())) {
+            CODEC_SHARE_PHASE(&stats_, COEFFICIENTS);
+            auto field    = uint8_t{(*token_)[uint8_t(seed)].first};
+            auto sparsity = uint8_t{(*token_)[uint8_t(seed)].second};
+            helpers::coefficients<Generator>(seed, field, sparsity, coef);
+            if (cache_)
+                cache_->insert<Generator>(seed, token_, capacity_, coef.data());
         }
-        data_.push_back(std::move(frame));
-        coef_.push_back(std::move(coef));
-        field_.push_back(field);
+        // sparse elimination (coefficients first, the payload is kept when innovative)
+        if (mode_ == Mode::SPARSE) {
+            program_.clear();
+            if (sparse_.push(row_.data(), program_) == helpers::sparse::NONE) {
+                CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
+                continue;
+            }
+            CODEC_SHARE_COUNT(&stats_, INNOVATIVE, 1);
+            ++innovative;
+            data_.push_back(std::move(frame));
+            run(program_);
+            if (sparse_.full())
+                solve();
+            continue;
+        }
+        // binary first elimination (coefficients reduced on the fly, the payload is kept
+        // with its received row when innovative and solved at full rank)
+        if (mixed_) {
+            auto row = pool_->frame(capacity_);
+            std::copy_n(row_.data(), capacity_, row.data());
+            auto none = helpers::none{};
+            if (helpers::reduce(capacity_, pivots_, coef_, row_, none) == helpers::NONE) {
+                CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
+                pool_->recycle(std::move(row));
+                continue;
+            }
+            CODEC_SHARE_COUNT(&stats_, INNOVATIVE, 1);
+            ++innovative;
+            auto field = seed::recoded(seed)    ? uint8_t{0xFF}
+                         : seed::reserved(seed) ? uint8_t{1}
+                                                : uint8_t{(*token_)[uint8_t(seed)].first};
+            field_.push_back(field <= 1 ? 1 : field);
+            rows_.push_back(std::move(row));
+            data_.push_back(std::move(frame));
+            if (pivots_.size() >= capacity_)
+                solve();
+            continue;
+        }
+        // on the fly elimination (coefficients first, the payload is kept when innovative)
+        if (mode_ == Mode::EAGER) {
+            program_.clear();
+            auto pos = helpers::NONE;
+            if (binary_.size()) {
+                pos = binary_.push(row_.data(), program_);
+                if (pos != helpers::NONE)
+                    pivots_.insert(std::next(std::begin(pivots_), pos), binary_.pivots()[pos]);
+            } else {
+                pos = helpers::reduce(capacity_, pivots_, coef_, row_, program_);
+            }
+            if (pos == helpers::NONE) {
+                CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
+                continue;
+            }
+            CODEC_SHARE_COUNT(&stats_, INNOVATIVE, 1);
+            ++innovative;
+            data_.push_back(std::move(frame));
+            auto length = data_.length();
+            {
+                CODEC_SHARE_PHASE(&stats_, PAYLOAD);
+                CODEC_SHARE_COUNT(&stats_, BYTES, program_.size() * length);
+                stripes(length, program_.size() * length, [this](size_t offset, size_t len) {
+                    program_.run(data_, offset, len);
+                });
+            }
+            std::rotate(
+              std::next(std::begin(data_), pos), std::prev(std::end(data_)), std::end(data_));
+            continue;
+        }
+        // coefficients only, the tail tracks the combination of received payload
+        row_[capacity_ + raw_.size()] = 1;
+        auto none = helpers::none{};
+        if (helpers::reduce(capacity_, pivots_, coef_, row_, none) != helpers::NONE) {
+            CODEC_SHARE_COUNT(&stats_, INNOVATIVE, 1);
+            ++innovative;
+            raw_.push_back(std::move(frame));
+            dirty_.assign(pivots_.size(), true);
+        } else {
+            CODEC_SHARE_COUNT(&stats_, REDUNDANT, 1);
+        }
+    }
+    CODEC_SHARE_SET(&stats_, RANK, std::max(pivots_.size(), sparse_.rank()));
+    // dropped frames back to the pool
+    pool_->recycle(std::move(data));
+    // decoded frames (leading pivots, mixed token rows are solved at full rank only)
+    for (size_ = 0; size_ < pivots_.size() && pivots_[size_] == size_;)
+        ++size_;
+    if (mixed_ && size_ < capacity_)
+        size_ = 0;
+    // full rank, combine payload once
+    if (pivots_.size() >= capacity_)
+        materialize(0, size_);
+    return innovative;
+}
+
+/// materialize
+/// @param first
+/// @param last
+/// @return data
+template <typename Vector, typename Generator>
+auto decoder<Vector, Generator>::materialize(size_t first, size_t last) const
+  -> const Container& {
+    if (mode_ == Mode::EAGER || raw_.empty())
+        return data_;
+    // rows to combine
+    pending_.clear();
+    for (auto i = first; i < last && i < dirty_.size(); ++i)
+        if (dirty_[i])
+            pending_.push_back(i);
+    if (pending_.empty())
+        return data_;
+    // combination of the received payload (data = T x raw)
+    CODEC_SHARE_BIND(&stats_);
+    CODEC_SHARE_PHASE(&stats_, PAYLOAD);
+    auto length = raw_.length();
+    CODEC_SHARE_COUNT(&stats_, BYTES, pending_.size() * raw_.size() * length);
+    if (data_.size() < dirty_.size())
+        data_.resize(dirty_.size());
+    tail_.clear();
+    out_.clear();
+    for (auto i : pending_) {
+        if (data_[i].capacity() < length)
+            data_[i] = pool_->frame(length);
+        data_[i].assign(length, 0);
+        tail_.push_back(coef_[i].data() + capacity_);
+        out_.emplace_back(data_[i].data(), length);
     }
-    size_ = helpers::solve(capacity_, field_, coef_, data_);
+    stripes(length, pending_.size() * raw_.size() * length, [&](size_t offset, size_t len) {
+        helpers::combine(raw_, tail_, out_, offset, offset + len);
+    });
+    for (auto i : pending_)
+        dirty_[i] = false;
+    return data_;
 }
 } // namespace share::codec
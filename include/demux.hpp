@@ -0,0 +1,126 @@
+/// ===============================================================================================
+/// @file      : demux.hpp                                                 |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "decoder.hpp"
+#include "header.hpp"
+
+namespace share::codec {
+
+/// ===============================================================================================
+/// demux
+/// @brief
+///   routes frames with a header to the decoder of their generation (hash map, O(1)),
+///   decoders are created on the first frame of a generation and removed on pop / erase,
+///   the ids of the last removed generations are retired (bounded), so their late frames
+///   are dropped instead of starting the generation again
+/// ===============================================================================================
+template <typename Vector, typename Generator = std::minstd_rand0>
+class demux {
+  public:
+    using Decoder   = decoder<Vector, Generator>;
+    using Container = typename Decoder::Container;
+    using Factory   = std::function<Decoder(uint32_t id, size_t size)>;
+
+    static constexpr size_t DEFAULT_RETIRED = 1024;
+
+    /// constructor
+    /// @param token
+    explicit demux(token::shared::Stamp token = token::get(token::Type::FULL))
+      : demux([token](uint32_t, size_t size) { return Decoder(size, token); }) {}
+
+    /// constructor
+    /// @param factory creates the decoder of a new generation (mode, pool, cache, ...)
+    /// @param retired number of removed generation ids kept to drop their late frames
+    explicit demux(Factory factory, size_t retired = DEFAULT_RETIRED)
+      : decoders_{}, factory_{std::move(factory)}, retired_{}, order_{}, limit_{retired} {}
+
+    /// push
+    /// @param frame with header
+    /// @return decoder of the frame generation,
+    ///         nullptr when the header is not valid or the generation is retired
+    Decoder* push(Vector frame) {
+        auto head = header{};
+        if (!header::parse(frame, head))
+            return nullptr;
+        if (retired_.count(head.id))
+            return nullptr;
+        auto it = decoders_.find(head.id);
+        if (it == decoders_.end())
+            it = decoders_.emplace(head.id, factory_(head.id, head.size)).first;
+        else if (it->second.capacity() != head.size)
+            return nullptr;
+        header::detach(frame);
+        it->second.push(std::move(frame));
+        return &it->second;
+    }
+
+    /// pop
+    /// @param id generation
+    /// @return decoded frames (the generation is removed and retired)
+    Container pop(uint32_t id) {
+        auto it = decoders_.find(id);
+        if (it == decoders_.end())
+            return {};
+        auto out = it->second.pop();
+        decoders_.erase(it);
+        retire(id);
+        return out;
+    }
+
+    /// erase
+    /// @param id generation (removed and retired)
+    void erase(uint32_t id) {
+        if (decoders_.erase(id))
+            retire(id);
+    }
+
+    /// retired
+    /// @param id generation
+    /// @return true when the late frames of the generation are dropped
+    bool retired(uint32_t id) const { return retired_.count(id) != 0; }
+
+    /// find
+    /// @param id generation
+    /// @return decoder of the generation, nullptr when unknown
+    Decoder* find(uint32_t id) {
+        auto it = decoders_.find(id);
+        return it == decoders_.end() ? nullptr : &it->second;
+    }
+
+    /// quantity
+    auto size() const { return decoders_.size(); }
+    auto empty() const { return decoders_.empty(); }
+    void reserve(size_t size) { decoders_.reserve(size); }
+
+  private:
+    std::unordered_map<uint32_t, Decoder> decoders_;
+    Factory factory_;
+    /// retired generations (oldest first)
+    std::unordered_set<uint32_t> retired_;
+    std::deque<uint32_t> order_;
+    size_t limit_;
+
+    /// retire
+    /// @param id generation
+    void retire(uint32_t id) {
+        if (limit_ == 0 || !retired_.insert(id).second)
+            return;
+        order_.push_back(id);
+        if (order_.size() > limit_) {
+            retired_.erase(order_.front());
+            order_.pop_front();
+        }
+    }
+};
+} // namespace share::codec
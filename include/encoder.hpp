@@ -8,10 +8,19 @@
 #pragma once
 
 #include <random>
+#include <stdexcept>
+#include <tuple>
 
 #include "container.hpp"
+#include "header.hpp"
+#include "pool.hpp"
+#include "seed.hpp"
+#include "span.hpp"
 #include "token.hpp"
 #include "helpers/combine.hpp"
+#include "helpers/matrix.hpp"
+#include "helpers/parallel.hpp"
+#include "helpers/stats.hpp"
 
 namespace share::codec {
 
@@ -23,6 +32,7 @@ class encoder {
     // helpers
     using Container = container<Vector>;
     using Value     = typename Vector::value_type;
+    using Pool      = std::shared_ptr<codec::pool<Vector>>;
 
     /// encode header size
     const size_t HEADER_SIZE = sizeof(uint32_t);
@@ -31,13 +41,23 @@ class encoder {
     /// @param capacity
     /// @param token
     encoder(size_t capacity = 100, token::shared::Stamp token = token::get(token::Type::FULL))
-      : data_{}, capacity_{capacity}, token_{token} {}
+      : data_{},
+        frames_{},
+        capacity_{capacity},
+        token_{token},
+        pool_{std::make_shared<codec::pool<Vector>>()} {}
 
     /// constructor
     /// @param data
     /// @param token
     encoder(Container data, token::shared::Stamp token = token::get(token::Type::FULL))
-      : data_(std::move(data)), capacity_(data.size()), token_(token) {}
+      : data_{},
+        frames_{},
+        capacity_{data.size()},
+        token_{token},
+        pool_{std::make_shared<codec::pool<Vector>>()} {
+        push(std::move(data));
+    }
 
     /// move constructor
     encoder(encoder&&) = default;
@@ -47,80 +67,281 @@ class encoder {
 
     /// push
     /// @param data
-    void push(Vector data) { data_.push_back(std::move(data)); }
+    void push(Vector data) {
+        check(data.size());
+        data_.push_back(std::move(data));
+        frames_.push_back({span{}, data_.size() - 1});
+    }
 
     /// push
     /// @param data
     void push(Container data) {
         for (auto& d : data)
-            data_.push(std::move(d));
+            push(std::move(d));
+    }
+
+    /// push
+    /// @brief non owning frame, the viewed memory must outlive the encoder frames
+    /// @param data
+    void push(span data) {
+        check(data.size());
+        frames_.push_back({data, NONE});
+    }
+
+    /// push
+    /// @brief non owning frames of a contiguous buffer split with a frame stride,
+    ///        only a partial last frame is copied (zero padded)
+    /// @param data
+    /// @param stride
+    void push(span data, size_t stride) {
+        auto offset = size_t{0};
+        for (; offset + stride <= data.size(); offset += stride)
+            push(data.subspan(offset, stride));
+        if (offset < data.size()) {
+            auto frame = Vector(stride, 0);
+            std::copy(std::next(data.begin(), offset), data.end(), std::begin(frame));
+            push(std::move(frame));
+        }
+    }
+
+    /// push
+    /// @brief non owning frames (scatter-gather list, one frame per buffer)
+    /// @param data
+    void push(const buffers& data) {
+        for (auto& d : data)
+            push(d);
+    }
+
+    /// pop
+    /// @brief reentrant, seeds are drawn from a per thread seed stream
+    /// @param size
+    auto pop(size_t size) const { return encode(size, seeds(), nullptr); }
+
+    /// pop
+    /// @brief reentrant, combinations are produced over column stripes on the workers
+    /// @param size
+    /// @param workers
+    auto pop(size_t size, helpers::parallel& workers) const {
+        return encode(size, seeds(), &workers);
     }
 
     /// pop
+    /// @brief reentrant, coded frames with a header (see demux)
+    /// @param size
+    /// @param id   generation id
+    /// @throw Container::exception when the generation exceeds the header size field
+    auto pop(size_t size, uint32_t id) const {
+        if (frames_.size() > header::CAPACITY)
+            throw typename Container::exception("generation size exceeds the header");
+        auto code = encode(size, seeds(), nullptr, header::EXTRA);
+        for (auto& frame : code)
+            header::attach(frame, id, uint16_t(frames_.size()));
+        return code;
+    }
+
+    /// systematic
+    /// @brief reentrant, source frames [first, first + size) unchanged with systematic seeds
+    /// @param first
     /// @param size
-    auto pop(size_t size);
+    /// @throw std::out_of_range when a frame index has no systematic seed (0xFFFF or above)
+    Container systematic(size_t first, size_t size) const;
+
+    /// encode
+    /// @brief reentrant, seeds are drawn from the given stream
+    /// @param size
+    /// @param seeds   callable returning 32 bit seeds
+    /// @param workers optional
+    /// @param extra   bytes reserved after the seed (header)
+    template <typename Seeds>
+    Container encode(
+      size_t size, Seeds&& seeds, helpers::parallel* workers = nullptr, size_t extra = 0) const;
 
     /// clear
-    void clear() { data_.clear(); }
+    void clear() {
+        data_.clear();
+        frames_.clear();
+    }
+
+    /// pool
+    /// @brief coded frames are drawn from the pool (may be shared with decoders)
+    /// @param pool
+    void pool(Pool pool) { pool_ = std::move(pool); }
+    auto& pool() const { return pool_; }
+
+    /// recycle
+    /// @brief hand consumed coded frames back to the pool
+    /// @param frames
+    void recycle(Container frames) { pool_->recycle(std::move(frames)); }
+
+#ifdef CODEC_SHARE_STATS
+    /// stats
+    /// @brief counters and phase timings (builds with CODEC_SHARE_STATS)
+    auto& stats() const { return stats_; }
+#endif
 
     /// iterators
-    /// @brief forward
+    /// @brief forward over the owned (copied) frames only, frames pushed as views are not
+    ///        part of the range, use size() and frame(n) to walk every frame
     auto begin() const { return data_.begin(); }
     auto end() const { return data_.end(); }
 
+    /// frame
+    /// @param n
+    /// @return view of frame n (owned or external)
+    span frame(size_t n) const {
+        auto& f = frames_.at(n);
+        return f.owned == NONE ? f.view : span{data_[f.owned]};
+    }
+
     /// quantity
-    auto full() { return (data_.size() >= capacity_); }
-    auto size() { return data_.size(); }
-    auto capacity() { return std::max(capacity_, data_.size()); }
+    auto full() { return (frames_.size() >= capacity_); }
+    auto size() { return frames_.size(); }
+    auto capacity() { return std::max(capacity_, frames_.size()); }
+    auto length() const { return frames_.empty() ? size_t{0} : frame(0).size(); }
 
   private:
+    static constexpr size_t NONE = ~size_t{0};
+
+    /// frame reference (external view, or owned row of data_)
+    struct reference {
+        span view;
+        size_t owned;
+    };
+
     /// data
     Container data_;
+    std::vector<reference> frames_;
     /// context
     size_t capacity_;
     // property
     token::shared::Stamp token_;
+    Pool pool_;
+#ifdef CODEC_SHARE_STATS
+    mutable helpers::stats stats_;
+#endif
+
+    /// check
+    /// @brief all frames share the same length
+    void check(size_t length) const {
+        if (!frames_.empty() && length != this->length())
+            throw typename Container::exception("unexpected container size");
+    }
+
+    /// seeds
+    /// @brief per thread seed stream, seeded once from Random
+    static auto& seeds() {
+        thread_local auto stream = std::mt19937{Random{}()};
+        return stream;
+    }
 };
 
 
-/// push
+/// encode
+/// @brief
+///   coefficients of all combinations are generated (and bad seeds rejected) first,
+///   then all combinations are produced in a single blocked pass over the data
 /// @param size
+/// @param seeds
+/// @param workers
+/// @param extra
 /// @return data
 template <typename Vector, typename Random, typename Generator>
-auto encoder<Vector, Random, Generator>::pop(size_t size) {
+template <typename Seeds>
+auto encoder<Vector, Random, Generator>::encode(
+  size_t size, Seeds&& seeds, helpers::parallel* workers, size_t extra) const -> Container {
+    CODEC_SHARE_BIND(&stats_);
     // coded container
-    Container code;
-    // random generetor
-    Random rand;
+    auto code = pool_->container();
+    // scratch (per thread, kept across calls), bound by reference for the workers
+    using Scratch = std::tuple<std::vector<span>, std::vector<uint32_t>, helpers::matrix>;
+    thread_local auto scratch = Scratch{};
+    auto& input = std::get<0>(scratch);
+    auto& seed  = std::get<1>(scratch);
+    auto& coefs = std::get<2>(scratch);
+    // sources
+    input.clear();
+    for (size_t j = 0; j < frames_.size(); ++j)
+        input.push_back(frame(j));
     // sizes
-    auto data_length = data_.length();
+    auto data_length = length();
     auto code_length = data_length + HEADER_SIZE;
-    // encode loop
+
+    // coefficients loop
+    seed.assign(size, 0);
+    coefs.reshape(size, input.size());
+    [[maybe_unused]] auto draws = size_t{0};
+    {
+        CODEC_SHARE_PHASE(&stats_, COEFFICIENTS);
+        for (unsigned int i = 0; i < size; i++) {
+            // field and sparsity
+            auto field    = uint8_t(0);
+            auto sparsity = uint8_t(0);
+            do {
+                do {
+                    seed[i] = uint32_t(seeds());
+                    ++draws;
+                } while (seed::reserved(seed[i]));
+                field    = (*token_)[uint8_t(seed[i])].first;
+                sparsity = (*token_)[uint8_t(seed[i])].second;
+            } while (helpers::coefficients<Generator>(seed[i], field, sparsity, coefs[i]) == 0);
+        }
+    }
+    CODEC_SHARE_COUNT(&stats_, RETRIES, draws - size);
+    CODEC_SHARE_COUNT(&stats_, FRAMES, size);
+    CODEC_SHARE_COUNT(&stats_, ROWOPS, size * input.size());
+    CODEC_SHARE_COUNT(&stats_, BYTES, size * input.size() * data_length);
+
+    // create combinations
+    CODEC_SHARE_PHASE(&stats_, PAYLOAD);
+    for (unsigned int i = 0; i < size; i++)
+        code.push_back(pool_->frame(data_length, code_length + extra));
+    auto combine = [&](size_t offset, size_t length) {
+        helpers::combine(input, coefs, code, offset, offset + length);
+    };
+    if (workers)
+        workers->run(data_length, size * input.size() * data_length, combine);
+    else
+        combine(0, data_length);
+
+    // insert seeds
     for (unsigned int i = 0; i < size; i++) {
-        // seed, field and sparsity
-        auto seed     = uint32_t(0);
-        auto field    = uint8_t(0);
-        auto sparsity = uint8_t(0);
-
-        // create combination
-        auto comb = Vector(code_length + sizeof(int));
-        comb.resize(data_length);
-        do {
-            seed     = rand();
-            field    = (*token_)[uint8_t(seed)].first;
-            sparsity = (*token_)[uint8_t(seed)].second;
-        } while (helpers::combine<Generator>(data_, seed, field, sparsity, comb) == 0);
+        auto& comb = code[i];
+        auto value = seed[i];
+        comb.push_back(uint8_t(value));
+        value >>= 8;
+        comb.push_back(uint8_t(value));
+        value >>= 8;
+        comb.push_back(uint8_t(value));
+        value >>= 8;
+        comb.push_back(uint8_t(value));
+    }
+    return code;
+}
 
+/// systematic
+/// @param first
+/// @param size
+/// @return data
+template <typename Vector, typename Random, typename Generator>
+auto encoder<Vector, Random, Generator>::systematic(size_t first, size_t size) const
+  -> Container {
+    auto last = std::min(frames_.size(), first + std::min(size, frames_.size()));
+    if (first < last && last > seed::INDEX)
+        throw std::out_of_range("systematic index exceeds the seed");
+    auto code = pool_->container();
+    for (auto i = first; i < last; ++i) {
+        auto source = frame(i);
+        auto comb   = pool_->frame(0, source.size() + HEADER_SIZE);
+        comb.assign(std::begin(source), std::end(source));
         // insert seed
-        comb.push_back(uint8_t(seed));
-        seed >>= 8;
-        comb.push_back(uint8_t(seed));
-        seed >>= 8;
-        comb.push_back(uint8_t(seed));
-        seed >>= 8;
-        comb.push_back(uint8_t(seed));
-        
-        // save combination
+        auto value = seed::systematic(i);
+        comb.push_back(uint8_t(value));
+        value >>= 8;
+        comb.push_back(uint8_t(value));
+        value >>= 8;
+        comb.push_back(uint8_t(value));
+        value >>= 8;
+        comb.push_back(uint8_t(value));
         code.push_back(std::move(comb));
     }
     return code;
@@ -0,0 +1,275 @@
+/// ===============================================================================================
+/// @file      : fixed.hpp                                                 |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "seed.hpp"
+#include "span.hpp"
+#include "token.hpp"
+#include "helpers/combine.hpp"
+#include "helpers/copy.hpp"
+#include "helpers/gf8.hpp"
+#include "helpers/matrix.hpp"
+
+namespace share::codec::fixed {
+
+/// ===============================================================================================
+/// encoder
+/// @brief
+///   encoder of a generation size K and a frame length N known at build time, the source frames
+///   are copied into in place arrays and coded frames are written into caller arrays (no heap
+///   allocation), the density of the TYPE token is a compile time constant (uniform stamps),
+///   coded frames [payload:N][seed:4] are those of codec::encoder (token::get(TYPE))
+/// ===============================================================================================
+template <
+  size_t K,
+  size_t N,
+  token::Type TYPE   = token::Type::FULL,
+  typename Random    = std::random_device,
+  typename Generator = std::minstd_rand0>
+class encoder {
+    static_assert(K > 0 && K <= seed::INDEX, "generation size out of range");
+    static_assert(N > 0, "empty frames");
+    static_assert(TYPE == token::Type::SPARSE || TYPE == token::Type::FULL, "uniform tokens only");
+
+  public:
+    /// encode header size
+    static constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+
+    /// density (token)
+    static constexpr uint8_t FIELD    = token::uniform(TYPE).first;
+    static constexpr uint8_t SPARSITY = token::uniform(TYPE).second;
+
+    /// frames
+    using Payload = std::array<uint8_t, N>;
+    using Frame   = std::array<uint8_t, N + HEADER_SIZE>;
+
+    /// constructor
+    encoder() : data_{}, size_{0} {}
+
+    /// push
+    /// @param data N bytes (copied)
+    /// @return false when the generation is full
+    bool push(const uint8_t* data) {
+        if (full())
+            return false;
+        std::copy_n(data, N, data_[size_++].data());
+        return true;
+    }
+
+    /// push
+    /// @param data
+    /// @return false when the generation is full
+    bool push(const Payload& data) { return push(data.data()); }
+
+    /// pop
+    /// @brief reentrant, seeds are drawn from a per thread seed stream
+    /// @param frame coded
+    /// @return false when the generation is empty
+    bool pop(Frame& frame) const { return encode(seeds(), frame); }
+
+    /// encode
+    /// @brief reentrant, seeds are drawn from the given stream
+    /// @param seeds callable returning 32 bit seeds
+    /// @param frame coded
+    /// @return false when the generation is empty
+    template <typename Seeds>
+    bool encode(Seeds&& seeds, Frame& frame) const;
+
+    /// systematic
+    /// @param index source frame
+    /// @param frame source frame unchanged with a systematic seed
+    /// @return false when there is no such frame
+    bool systematic(size_t index, Frame& frame) const {
+        if (index >= size_)
+            return false;
+        std::copy_n(data_[index].data(), N, frame.data());
+        helpers::copy(seed::systematic(index), std::next(frame.data(), N));
+        return true;
+    }
+
+    /// clear
+    void clear() { size_ = 0; }
+
+    /// quantity
+    auto full() const { return size_ >= K; }
+    auto size() const { return size_; }
+    static constexpr auto capacity() { return K; }
+    static constexpr auto length() { return N; }
+
+  private:
+    /// data
+    std::array<Payload, K> data_;
+    /// context
+    size_t size_;
+
+    /// seeds
+    /// @brief per thread seed stream, seeded once from Random
+    static auto& seeds() {
+        thread_local auto stream = std::mt19937{Random{}()};
+        return stream;
+    }
+};
+
+/// encode
+/// @param seeds
+/// @param frame
+/// @return false when the generation is empty
+template <size_t K, size_t N, token::Type TYPE, typename Random, typename Generator>
+template <typename Seeds>
+bool encoder<K, N, TYPE, Random, Generator>::encode(Seeds&& seeds, Frame& frame) const {
+    if (size_ == 0)
+        return false;
+    // coefficients (one per source frame, as codec::encoder)
+    auto coef = std::array<uint8_t, K>{};
+    auto row  = helpers::row(coef.data(), size_);
+    auto seed = uint32_t{0};
+    do {
+        do {
+            seed = uint32_t(seeds());
+        } while (seed::reserved(seed));
+    } while (helpers::coefficients<Generator>(seed, FIELD, SPARSITY, row) == 0);
+    // combination
+    std::fill_n(frame.data(), N, uint8_t{0});
+    for (size_t j = 0; j < size_; ++j)
+        helpers::gf8::muladd(frame.data(), data_[j].data(), N, coef[j]);
+    // insert seed
+    helpers::copy(seed, std::next(frame.data(), N));
+    return true;
+}
+
+/// ===============================================================================================
+/// decoder
+/// @brief
+///   decoder of a generation size K and a frame length N known at build time, each basis row
+///   holds its coefficients and payload side by side [coefficients:K][payload:N] in place
+///   (no heap allocation), so a single region operation reduces both, the rows are kept in
+///   reduced echelon form indexed by pivot (row c is zero before column c, row operations
+///   start at the pivot), coded, systematic and recoded frames of codec::encoder and
+///   codec::recoder are accepted
+/// ===============================================================================================
+template <
+  size_t K,
+  size_t N,
+  token::Type TYPE   = token::Type::FULL,
+  typename Generator = std::minstd_rand0>
+class decoder {
+    static_assert(K > 0 && K <= seed::INDEX, "generation size out of range");
+    static_assert(N > 0, "empty frames");
+    static_assert(TYPE == token::Type::SPARSE || TYPE == token::Type::FULL, "uniform tokens only");
+
+  public:
+    /// encode header size
+    static constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+
+    /// density (token)
+    static constexpr uint8_t FIELD    = token::uniform(TYPE).first;
+    static constexpr uint8_t SPARSITY = token::uniform(TYPE).second;
+
+    /// frames
+    using Frame   = std::array<uint8_t, N + HEADER_SIZE>;
+    using Recoded = std::array<uint8_t, N + K + HEADER_SIZE>;
+
+    /// constructor
+    decoder() : rows_{}, row_{}, pivots_{}, rank_{0} {}
+
+    /// push
+    /// @param frame coded (N + 4 bytes) or recoded (N + K + 4 bytes)
+    /// @param size
+    /// @return true when the frame is innovative
+    bool push(const uint8_t* frame, size_t size);
+
+    /// push
+    /// @param frame
+    /// @return true when the frame is innovative
+    bool push(const Frame& frame) { return push(frame.data(), frame.size()); }
+    bool push(const Recoded& frame) { return push(frame.data(), frame.size()); }
+
+    /// at
+    /// @param n
+    /// @return view of the decoded frame n (full rank)
+    span at(size_t n) const { return {rows_[n].data() + K, N}; }
+
+    /// clear
+    void clear() {
+        pivots_.fill(false);
+        rank_ = 0;
+    }
+
+    /// quantity
+    auto full() const { return rank_ >= K; }
+    auto rank() const { return rank_; }
+    static constexpr auto capacity() { return K; }
+    static constexpr auto length() { return N; }
+
+  private:
+    using Row = std::array<uint8_t, K + N>;
+
+    /// basis (row c has its pivot at column c)
+    std::array<Row, K> rows_;
+    /// frame being pushed
+    Row row_;
+    /// context
+    std::array<bool, K> pivots_;
+    size_t rank_;
+};
+
+/// push
+/// @param frame
+/// @param size
+/// @return true when the frame is innovative
+template <size_t K, size_t N, token::Type TYPE, typename Generator>
+bool decoder<K, N, TYPE, Generator>::push(const uint8_t* frame, size_t size) {
+    if (full() || size < HEADER_SIZE)
+        return false;
+    // remove seed
+    auto seed = uint32_t{0};
+    helpers::copy(frame + size - HEADER_SIZE, seed);
+    size -= HEADER_SIZE;
+    // coefficients (explicit, identity row or generated)
+    if (seed::recoded(seed)) {
+        if (size != N + K)
+            return false;
+        std::copy_n(frame + N, K, row_.data());
+    } else if (size != N) {
+        return false;
+    } else if (seed::reserved(seed)) {
+        if (seed::index(seed) >= K)
+            return false;
+        row_.fill(0);
+        row_[seed::index(seed)] = 1;
+    } else {
+        auto coef = helpers::row(row_.data(), K);
+        helpers::coefficients<Generator>(seed, FIELD, SPARSITY, coef);
+    }
+    std::copy_n(frame, N, row_.data() + K);
+    // reduce by the basis
+    for (size_t c = 0; c < K; ++c)
+        if (pivots_[c] && row_[c])
+            helpers::gf8::muladd(row_.data() + c, rows_[c].data() + c, K + N - c, row_[c]);
+    // pivot
+    auto c = size_t{0};
+    while (c < K && row_[c] == 0)
+        ++c;
+    if (c == K)
+        return false;
+    helpers::gf8::mul(row_.data() + c, K + N - c, helpers::gf8::kernel::INVERSE[row_[c]]);
+    // unify (rows of lower pivots)
+    for (size_t p = 0; p < c; ++p)
+        if (pivots_[p] && rows_[p][c])
+            helpers::gf8::muladd(rows_[p].data() + c, row_.data() + c, K + N - c, rows_[p][c]);
+    // insert (columns before the pivot are zero and never read)
+    std::copy(std::next(std::begin(row_), c), std::end(row_), std::next(std::begin(rows_[c]), c));
+    pivots_[c] = true;
+    ++rank_;
+    return true;
+}
+} // namespace share::codec::fixed
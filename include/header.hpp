@@ -0,0 +1,83 @@
+/// ===============================================================================================
+/// @file      : header.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "helpers/copy.hpp"
+
+namespace share::codec {
+
+/// ===============================================================================================
+/// header
+/// @brief
+///   opt-in versioned frame header, appended after the seed of a coded frame so that
+///   stripping it leaves a plain coded frame, layout (little endian):
+///   [payload][seed:4][length:4][size:2][id:4][version:1]
+/// ===============================================================================================
+struct header {
+    static constexpr uint8_t VERSION = 1;
+    /// bytes after the payload (seed included)
+    static constexpr size_t SIZE = 15;
+    /// bytes after the seed
+    static constexpr size_t EXTRA = SIZE - sizeof(uint32_t);
+    /// largest generation size (size field)
+    static constexpr size_t CAPACITY = 0xFFFF;
+
+    /// fields
+    uint32_t id;
+    uint16_t size;
+    uint32_t length;
+    uint32_t seed;
+    uint8_t version;
+
+    /// parse
+    /// @brief read the header at the end of a frame (no allocation)
+    /// @param frame
+    /// @param out
+    /// @return true when the header is valid
+    template <typename Vector>
+    static bool parse(const Vector& frame, header& out) {
+        if (frame.size() < SIZE)
+            return false;
+        auto it = std::prev(std::end(frame), SIZE);
+        it      = helpers::copy(it, out.seed);
+        it      = helpers::copy(it, out.length);
+        it      = helpers::copy(it, out.size);
+        it      = helpers::copy(it, out.id);
+        it      = helpers::copy(it, out.version);
+        return out.version == VERSION && out.size != 0 && out.length == frame.size() - SIZE;
+    }
+
+    /// attach
+    /// @brief append the header fields to a coded frame (payload and seed)
+    /// @param frame
+    /// @param id   generation id
+    /// @param size generation size
+    template <typename Vector>
+    static void attach(Vector& frame, uint32_t id, uint16_t size) {
+        auto length = uint32_t(frame.size() - sizeof(uint32_t));
+        frame.resize(frame.size() + EXTRA);
+        auto it = std::prev(std::end(frame), EXTRA);
+        it      = helpers::copy(length, it);
+        it      = helpers::copy(size, it);
+        it      = helpers::copy(id, it);
+        it      = helpers::copy(VERSION, it);
+    }
+
+    /// detach
+    /// @brief remove the header fields (a plain coded frame is left)
+    /// @param frame
+    template <typename Vector>
+    static void detach(Vector& frame) {
+        frame.resize(frame.size() - EXTRA);
+    }
+};
+} // namespace share::codec
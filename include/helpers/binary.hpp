@@ -0,0 +1,177 @@
+/// ===============================================================================================
+/// @file      : binary.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "program.hpp"
+#include "stats.hpp"
+
+namespace share::codec::helpers {
+
+/// bits
+/// @brief GF(2) rows packed 64 coefficients per word (column c is bit c % 64 of word c / 64)
+namespace bits {
+    /// words of a row of size columns
+    static inline size_t words(size_t size) { return (size + 63) / 64; }
+
+    /// test
+    static inline bool test(const uint64_t* row, size_t c) { return (row[c / 64] >> (c % 64)) & 1; }
+
+    /// pack
+    /// @brief bytes (0 or 1) to bits
+    static inline void pack(const uint8_t* in, size_t size, uint64_t* out) {
+        std::fill(out, out + words(size), uint64_t{0});
+        for (size_t c = 0; c < size; ++c)
+            out[c / 64] |= uint64_t(in[c] & 1) << (c % 64);
+    }
+
+    /// unpack
+    /// @brief bits to bytes (0 or 1)
+    static inline void unpack(const uint64_t* in, size_t size, uint8_t* out) {
+        for (size_t c = 0; c < size; ++c)
+            out[c] = uint8_t((in[c / 64] >> (c % 64)) & 1);
+    }
+
+    /// add
+    /// @brief (a += b) from the word of column c
+    static inline void add(uint64_t* a, const uint64_t* b, size_t c, size_t size) {
+        for (auto w = c / 64, ww = words(size); w < ww; ++w)
+            a[w] ^= b[w];
+    }
+
+    /// find
+    /// @return first set column in [c, size), or size
+    static inline size_t find(const uint64_t* row, size_t c, size_t size) {
+        for (auto w = c / 64, ww = words(size); w < ww; ++w) {
+            auto word = row[w];
+            if (w == c / 64)
+                word &= ~uint64_t{0} << (c % 64);
+            if (word)
+                return std::min(w * 64 + size_t(__builtin_ctzll(word)), size);
+        }
+        return size;
+    }
+
+    /// scatter
+    /// @brief (out[c] += factor) on the set columns of a row
+    static inline void scatter(const uint64_t* row, size_t size, uint8_t factor, uint8_t* out) {
+        for (size_t w = 0, ww = words(size); w < ww; ++w)
+            for (auto word = row[w]; word; word &= word - 1)
+                out[w * 64 + size_t(__builtin_ctzll(word))] ^= factor;
+    }
+} // namespace bits
+
+/// binary
+/// @brief
+/// on the fly gauss-jordan over GF(2), the counterpart of reduce for rows of 0 / 1 coefficients
+/// (token field mask 1), the basis is bit packed and sorted by pivot column, rows are reduced
+/// with word wide xor, the pivot is found with ctz and the payload operations are plain sums
+/// (factor 1), forwarded to data where the new row is the one after the basis
+class binary {
+  public:
+    static constexpr size_t NONE = ~size_t{0};
+
+    /// constructor
+    /// @param size number of columns
+    explicit binary(size_t size = 0)
+      : rows_{}, pivots_{}, row_(bits::words(size), 0), size_{size} {}
+
+    /// push
+    /// @param coef dense coefficients (size columns of 0 or 1)
+    /// @param data payload operations
+    /// @return position of the new row in the basis, or NONE when not innovative
+    template <typename Data>
+    size_t push(const uint8_t* coef, Data& data) {
+        bits::pack(coef, size_, row_.data());
+        return push(data);
+    }
+
+    /// unpack
+    /// @brief basis row at position n as dense coefficients
+    void unpack(size_t n, uint8_t* out) const { bits::unpack(row(n), size_, out); }
+
+    /// clear
+    void clear() {
+        rows_.clear();
+        pivots_.clear();
+    }
+
+    /// quantity
+    auto rank() const { return pivots_.size(); }
+    auto size() const { return size_; }
+    auto full() const { return pivots_.size() >= size_; }
+    auto& pivots() const { return pivots_; }
+    /// bytes held
+    auto memory() const {
+        return (rows_.capacity() + row_.capacity()) * sizeof(uint64_t)
+               + pivots_.capacity() * sizeof(size_t);
+    }
+
+  private:
+    /// basis (rank x words, sorted by pivot)
+    std::vector<uint64_t> rows_;
+    std::vector<size_t> pivots_;
+    /// row being pushed
+    std::vector<uint64_t> row_;
+    size_t size_;
+
+    uint64_t* row(size_t n) { return rows_.data() + n * row_.size(); }
+    const uint64_t* row(size_t n) const { return rows_.data() + n * row_.size(); }
+
+    /// push
+    /// @brief reduce the packed row_ against the basis and insert it
+    template <typename Data>
+    size_t push(Data& data) {
+        auto index = pivots_.size();
+        auto words = row_.size();
+        [[maybe_unused]] auto ops = size_t{0};
+        // forward elimination (remove basis pivots from the new row)
+        {
+            CODEC_SHARE_PHASE(stats::current(), FORWARD);
+            for (size_t i = 0; i < pivots_.size(); ++i) {
+                if (!bits::test(row_.data(), pivots_[i]))
+                    continue;
+                bits::add(row_.data(), row(i), pivots_[i], size_);
+                rows::muladd(data, index, i, 1);
+                ++ops;
+            }
+        }
+        // find pivot
+        auto pivot = bits::find(row_.data(), 0, size_);
+        if (pivot >= size_) {
+            CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+            CODEC_SHARE_COUNT(stats::current(), BYTES, ops * rows::length(data));
+            return NONE;
+        }
+        // backward elimination (remove the new pivot from the basis)
+        {
+            CODEC_SHARE_PHASE(stats::current(), BACKWARD);
+            for (size_t i = 0; i < pivots_.size(); ++i) {
+                if (!bits::test(row(i), pivot))
+                    continue;
+                bits::add(row(i), row_.data(), pivot, size_);
+                rows::muladd(data, i, index, 1);
+                ++ops;
+            }
+        }
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+        CODEC_SHARE_COUNT(stats::current(), BYTES, ops * rows::length(data));
+        // insert ordered by pivot
+        auto pos = size_t(std::distance(
+          std::begin(pivots_), std::lower_bound(std::begin(pivots_), std::end(pivots_), pivot)));
+        pivots_.insert(std::next(std::begin(pivots_), pos), pivot);
+        rows_.insert(
+          std::next(std::begin(rows_), pos * words), std::begin(row_), std::end(row_));
+        return pos;
+    }
+};
+} // namespace share::codec::helpers
@@ -0,0 +1,119 @@
+/// ===============================================================================================
+/// @file      : cache.hpp                                                 |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace share::codec::helpers {
+
+/// cache
+/// @brief
+/// bounded (least recently used) cache of coefficient rows keyed by (generator, seed, token,
+/// capacity), thread safe so it can be shared by the decoders of a receiver
+class cache {
+    static constexpr size_t DEFAULT_LIMIT = 4096;
+
+  public:
+    /// constructor
+    /// @param limit maximum number of rows
+    explicit cache(size_t limit = DEFAULT_LIMIT)
+      : mutex_{}, rows_{}, index_{}, limit_{limit}, hits_{}, misses_{} {}
+
+    /// find
+    /// @brief copy the cached row of the key into out
+    /// @return true when found
+    template <typename Generator, typename Token>
+    bool find(uint32_t seed, const Token& token, size_t capacity, uint8_t* out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find({typeid(Generator), seed, token.get(), capacity});
+        if (it == index_.end()) {
+            ++misses_;
+            return false;
+        }
+        rows_.splice(rows_.begin(), rows_, it->second);
+        std::copy(std::begin(it->second->row), std::end(it->second->row), out);
+        ++hits_;
+        return true;
+    }
+
+    /// insert
+    /// @brief store a copy of the row of the key
+    template <typename Generator, typename Token>
+    void insert(uint32_t seed, const Token& token, size_t capacity, const uint8_t* row) {
+        if (limit_ == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto key = Key{typeid(Generator), seed, token.get(), capacity};
+        if (index_.count(key))
+            return;
+        if (rows_.size() >= limit_) {
+            index_.erase(rows_.back().key);
+            rows_.pop_back();
+        }
+        rows_.push_front({key, token, std::vector<uint8_t>(row, row + capacity)});
+        index_.emplace(key, rows_.begin());
+    }
+
+    /// quantity
+    auto size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rows_.size();
+    }
+    auto limit() const { return limit_; }
+    auto hits() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+    auto misses() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+  private:
+    /// key (the token is held by the entry, so its address is not reused, decoders with
+    /// different generators produce different rows of the same seed)
+    struct Key {
+        std::type_index generator;
+        uint32_t seed;
+        const void* token;
+        size_t capacity;
+
+        bool operator==(const Key& o) const {
+            return generator == o.generator && seed == o.seed && token == o.token
+                   && capacity == o.capacity;
+        }
+    };
+    struct Hash {
+        size_t operator()(const Key& k) const {
+            auto h = std::hash<const void*>{}(k.token) ^ k.generator.hash_code();
+            h ^= (size_t(k.seed) << 16) ^ k.capacity;
+            return h * 0x9E3779B97F4A7C15ull;
+        }
+    };
+    struct Entry {
+        Key key;
+        std::shared_ptr<const void> token;
+        std::vector<uint8_t> row;
+    };
+
+    std::mutex mutex_;
+    std::list<Entry> rows_;
+    std::unordered_map<Key, std::list<Entry>::iterator, Hash> index_;
+    size_t limit_;
+    size_t hits_;
+    size_t misses_;
+};
+} // namespace share::codec::helpers
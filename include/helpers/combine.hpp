@@ -7,36 +7,76 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
+#include "generator.hpp"
 #include "gf8.hpp"
 
 namespace share::codec::helpers {
 
-template <typename Generator, typename Vector, typename Matrix>
-static inline auto
-combine(const Matrix& input, uint32_t seed, uint8_t field, uint8_t sparsity, Vector& output) {
+/// cache budget of a combine block (output tiles + input tile)
+static constexpr size_t COMBINE_BLOCK_BUDGET = size_t{1} << 18;
+static constexpr size_t COMBINE_BLOCK_MIN    = size_t{1} << 10;
+
+/// coefficients
+/// @brief generate the combination coefficients of a seed
+/// @return number of non zero coefficients
+template <typename Generator, typename Vector>
+static inline auto coefficients(uint32_t seed, uint8_t field, uint8_t sparsity, Vector& output) {
     using Value = typename Vector::value_type;
-    // combine loop
-    auto aux     = Vector(output.capacity());
     auto gen     = Generator{seed};
-    auto factor  = Value{0};
     auto counter = size_t{0};
-    for (auto& frame : input) {
-        factor = gen();
-        if (factor > sparsity)
-            continue;
-        factor &= field;
-        if (factor == 0)
-            continue;
-        // copy for calculation process
-        aux.assign(frame.begin(), frame.end());
-        // calculation process (Y += Xn * Cn)
-        gf8::sum(output, gf8::mul(aux, factor));
-        // track number of merges
-        ++counter;
+    if constexpr (bulk<Generator>::value) {
+        // batch of bytes then masks (vectorized)
+        gen.fill(output.data(), output.size());
+        for (auto& val : output) {
+            val = (val > sparsity) ? Value{0} : Value(val & field);
+            counter += (val != 0);
+        }
+        return counter;
+    }
+    for (auto& val : output) {
+        auto factor = Value(gen());
+        val         = (factor > sparsity) ? Value{0} : Value(factor & field);
+        counter += (val != 0);
     }
     return counter;
 }
-} // namespace share::codec::helpers
\ No newline at end of file
+
+/// combine
+/// @brief matrix product (output += coef x input) over column blocks,
+///        each input block is loaded once and accumulated into all outputs
+/// @param input  sources  (n rows)
+/// @param coef   coefficients (m rows of n)
+/// @param output combinations (m rows)
+/// @param first  first column
+/// @param last   last column (excluded)
+template <typename Input, typename Coefficients, typename Output>
+static inline void combine(
+  const Input& input, const Coefficients& coef, Output& output, size_t first, size_t last) {
+    if (input.empty() || output.empty()) {
+        return;
+    }
+    auto block = std::max(COMBINE_BLOCK_BUDGET / (output.size() + 1), COMBINE_BLOCK_MIN);
+    block &= ~size_t{63};
+    for (auto offset = first; offset < last; offset += block) {
+        auto len = std::min(block, last - offset);
+        for (auto j = size_t{0}; j < input.size(); ++j) {
+            auto src = input[j].data() + offset;
+            for (auto i = size_t{0}; i < output.size(); ++i)
+                gf8::muladd(output[i].data() + offset, src, len, coef[i][j]);
+        }
+    }
+}
+
+/// combine
+/// @brief matrix product (output += coef x input) of whole rows
+template <typename Input, typename Coefficients, typename Output>
+static inline void combine(const Input& input, const Coefficients& coef, Output& output) {
+    if (!output.empty()) {
+        combine(input, coef, output, 0, output.front().size());
+    }
+}
+} // namespace share::codec::helpers
@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
 namespace share::codec::helpers {
 /// copy
 /// @brief serialize a interger to a iterator
@@ -15,16 +19,16 @@ namespace share::codec::helpers {
 template <typename Iterator>
 std::enable_if_t<std::is_same_v<typename std::iterator_traits<Iterator>::value_type, uint8_t>, Iterator>
 copy(uint32_t num, Iterator it) {
-    *it = uint8_t(num), ++it, num <<= 8;
-    *it = uint8_t(num), ++it, num <<= 8;
-    *it = uint8_t(num), ++it, num <<= 8;
+    *it = uint8_t(num), ++it, num >>= 8;
+    *it = uint8_t(num), ++it, num >>= 8;
+    *it = uint8_t(num), ++it, num >>= 8;
     *it = uint8_t(num), ++it;
     return it;
 }
 template <typename Iterator>
 std::enable_if_t<std::is_same_v<typename std::iterator_traits<Iterator>::value_type, uint8_t>, Iterator>
 copy(uint16_t num, Iterator it) {
-    *it = uint8_t(num), ++it, num <<= 8;
+    *it = uint8_t(num), ++it, num >>= 8;
     *it = uint8_t(num), ++it;
     return it;
 }
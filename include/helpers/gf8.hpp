@@ -7,12 +7,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <type_traits>
+
+#include "kernel.hpp"
 
 namespace share::codec::helpers {
 namespace gf8 {
-    static constexpr int INT_MASK = ~int(sizeof(int) - 1);
-    static const int V2P[]        = {
+    static const int V2P[] = {
       512, 0,   1,   25,  2,   50,  26,  198, 3,   223, 51,  238, 27,  104, 199, 75,  4,   100, 224,
       14,  52,  141, 239, 129, 28,  193, 105, 248, 200, 8,   76,  113, 5,   138, 101, 47,  225, 36,
       15,  33,  53,  147, 142, 218, 240, 18,  130, 69,  29,  181, 194, 125, 106, 39,  249, 185, 201,
@@ -106,56 +109,83 @@ namespace gf8 {
     static inline Vector& mul(Vector& b, uint8_t m) {
         static_assert(std::is_same_v<typename Vector::value_type, uint8_t>);
         if (m == 0) {
-            fill(b.begin(), b.end(), 0);
+            std::fill(b.begin(), b.end(), 0);
             return b;
         }
         if (m == 1) {
             return b;
         }
-        auto M = V2P[m];
-        for (auto p0 = b.data(), pe = p0 + b.size(); p0 < pe; ++p0) {
-            *p0 = P2V[V2P[*p0] + M];
-        }
+        kernel::get().mul(b.data(), b.size(), m);
         return b;
     }
 
     template <typename Vector>
     static inline Vector& mul(Vector& b, uint8_t m, size_t i) {
         static_assert(std::is_same_v<typename Vector::value_type, uint8_t>);
+        if (i >= b.size()) {
+            return b;
+        }
         if (m == 0) {
-            fill(b.begin() + i, b.end(), 0);
+            std::fill(b.begin() + i, b.end(), 0);
             return b;
         }
         if (m == 1) {
             return b;
         }
-        auto M = V2P[m];
-        for (auto p0 = b.data() + i, pe = b.data() + b.size(); p0 < pe; ++p0) {
-            *p0 = P2V[V2P[*p0] + M];
-        }
+        kernel::get().mul(b.data() + i, b.size() - i, m);
         return b;
     }
 
     template <typename Vector>
     static inline Vector& sum(Vector& a, Vector& b) {
         static_assert(std::is_same_v<typename Vector::value_type, uint8_t>);
-        int* p0 = reinterpret_cast<int*>(a.data());
-        int* p1 = reinterpret_cast<int*>(b.data());
-        int* pe = reinterpret_cast<int*>(a.data() + a.size());
-        for (; p0 < pe; ++p0, ++p1) {
-            *p0 ^= *p1;
-        }
+        kernel::get().sum(a.data(), b.data(), a.size());
         return a;
     }
 
     template <typename Vector>
     static inline Vector& sum(Vector& a, Vector& b, size_t i) {
         static_assert(std::is_same_v<typename Vector::value_type, uint8_t>);
-        int* p0 = reinterpret_cast<int*>(a.data() + (i & INT_MASK));
-        int* p1 = reinterpret_cast<int*>(b.data() + (i & INT_MASK));
-        int* pe = reinterpret_cast<int*>(a.data() + a.size());
-        for (; p0 < pe; ++p0, ++p1) {
-            *p0 ^= *p1;
+        if (i >= a.size()) {
+            return a;
+        }
+        kernel::get().sum(a.data() + i, b.data() + i, a.size() - i);
+        return a;
+    }
+
+    /// mul
+    /// @brief (a = a * m) over a region of len bytes
+    static inline void mul(uint8_t* a, size_t len, uint8_t m) {
+        if (m == 0) {
+            std::fill(a, a + len, 0);
+            return;
+        }
+        if (m == 1) {
+            return;
+        }
+        kernel::get().mul(a, len, m);
+    }
+
+    /// muladd
+    /// @brief fused (a += b * m) over a region of len bytes
+    static inline void muladd(uint8_t* a, const uint8_t* b, size_t len, uint8_t m) {
+        if (m == 0) {
+            return;
+        }
+        if (m == 1) {
+            kernel::get().sum(a, b, len);
+            return;
+        }
+        kernel::get().muladd(a, b, len, m);
+    }
+
+    /// muladd
+    /// @brief fused (a += b * m) from offset i, b is read once and a written once
+    template <typename Vector, typename Source>
+    static inline Vector& muladd(Vector& a, const Source& b, uint8_t m, size_t i = 0) {
+        static_assert(std::is_same_v<typename Vector::value_type, uint8_t>);
+        if (i < a.size()) {
+            muladd(a.data() + i, b.data() + i, a.size() - i, m);
         }
         return a;
     }
@@ -0,0 +1,360 @@
+/// ===============================================================================================
+/// @file      : kernel.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHARE_CODEC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace share::codec::helpers {
+namespace gf8::kernel {
+    /// GF(2^8) polynomial (x^8 + x^4 + x^3 + x^2 + 1)
+    static constexpr unsigned POLYNOMIAL = 0x11D;
+
+    /// product
+    /// @brief carry-less multiplication reduced by the field polynomial
+    static constexpr uint8_t product(uint8_t a, uint8_t b) {
+        auto r = uint8_t{0};
+        for (; b; b >>= 1) {
+            if (b & 1)
+                r ^= a;
+            a = uint8_t((a << 1) ^ ((a & 0x80) ? (POLYNOMIAL & 0xFF) : 0));
+        }
+        return r;
+    }
+
+    /// Split
+    /// @brief nibble split tables of a constant: m * x = lo[x & 0xF] ^ hi[x >> 4]
+    struct Split {
+        alignas(16) uint8_t lo[16];
+        alignas(16) uint8_t hi[16];
+
+        inline uint8_t operator()(uint8_t x) const { return lo[x & 0xF] ^ hi[x >> 4]; }
+    };
+
+    /// split tables of every constant
+    inline constexpr auto SPLIT = []() {
+        auto tables = std::array<Split, 256>{};
+        for (unsigned m = 0; m < 256; ++m) {
+            for (unsigned i = 0; i < 16; ++i) {
+                tables[m].lo[i] = product(uint8_t(m), uint8_t(i));
+                tables[m].hi[i] = product(uint8_t(m), uint8_t(i << 4));
+            }
+        }
+        return tables;
+    }();
+
+    /// inverse of every constant (a^254, 0 has none)
+    inline constexpr auto INVERSE = []() {
+        auto inverse = std::array<uint8_t, 256>{};
+        for (unsigned a = 1; a < 256; ++a) {
+            auto x = uint8_t(a);
+            auto r = uint8_t{1};
+            for (unsigned e = 254; e; e >>= 1, x = product(x, x))
+                if (e & 1)
+                    r = product(r, x);
+            inverse[a] = r;
+        }
+        return inverse;
+    }();
+
+    /// affine bit matrices (x -> m * x) of every constant, in gf2p8affineqb layout
+    inline constexpr auto AFFINE = []() {
+        auto matrices = std::array<uint64_t, 256>{};
+        for (unsigned m = 0; m < 256; ++m) {
+            for (unsigned bit = 0; bit < 8; ++bit) {
+                auto col = product(uint8_t(m), uint8_t(1u << bit));
+                for (unsigned row = 0; row < 8; ++row)
+                    if (col & (1u << row))
+                        matrices[m] |= uint64_t{1} << ((7 - row) * 8 + bit);
+            }
+        }
+        return matrices;
+    }();
+
+    /// Kernel
+    /// @brief region operations of one instruction set tier
+    ///  - mul: dst[i] = m * dst[i]
+    ///  - sum: dst[i] = dst[i] + src[i]
+    ///  - muladd: dst[i] = dst[i] + m * src[i]
+    struct Kernel {
+        const char* name;
+        bool (*supported)();
+        void (*mul)(uint8_t* dst, size_t len, uint8_t m);
+        void (*sum)(uint8_t* dst, const uint8_t* src, size_t len);
+        void (*muladd)(uint8_t* dst, const uint8_t* src, size_t len, uint8_t m);
+    };
+
+    /// -------------------------------------------------------------------------------------------
+    /// scalar
+    /// -------------------------------------------------------------------------------------------
+    namespace scalar {
+        static inline bool supported() { return true; }
+
+        static inline void mul(uint8_t* dst, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            for (auto end = dst + len; dst < end; ++dst)
+                *dst = split(*dst);
+        }
+
+        static inline void sum(uint8_t* dst, const uint8_t* src, size_t len) {
+            for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t)) {
+                uint64_t a, b;
+                std::memcpy(&a, dst, sizeof(a));
+                std::memcpy(&b, src, sizeof(b));
+                a ^= b;
+                std::memcpy(dst, &a, sizeof(a));
+                dst += sizeof(uint64_t), src += sizeof(uint64_t);
+            }
+            for (; len; --len)
+                *dst++ ^= *src++;
+        }
+
+        static inline void muladd(uint8_t* dst, const uint8_t* src, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            for (auto end = dst + len; dst < end; ++dst, ++src)
+                *dst ^= split(*src);
+        }
+    } // namespace scalar
+
+#ifdef SHARE_CODEC_X86
+    /// -------------------------------------------------------------------------------------------
+    /// ssse3
+    /// -------------------------------------------------------------------------------------------
+    namespace ssse3 {
+        static inline bool supported() { return __builtin_cpu_supports("ssse3"); }
+
+        __attribute__((target("ssse3"))) static inline void
+        mul(uint8_t* dst, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            auto lo     = _mm_load_si128(reinterpret_cast<const __m128i*>(split.lo));
+            auto hi     = _mm_load_si128(reinterpret_cast<const __m128i*>(split.hi));
+            auto mask   = _mm_set1_epi8(0x0F);
+            for (; len >= 16; len -= 16, dst += 16) {
+                auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                auto l = _mm_shuffle_epi8(lo, _mm_and_si128(x, mask));
+                auto h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(x, 4), mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_xor_si128(l, h));
+            }
+            for (; len; --len, ++dst)
+                *dst = split(*dst);
+        }
+
+        __attribute__((target("sse2"))) static inline void
+        sum(uint8_t* dst, const uint8_t* src, size_t len) {
+            for (; len >= 16; len -= 16, dst += 16, src += 16) {
+                auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_xor_si128(a, b));
+            }
+            scalar::sum(dst, src, len);
+        }
+
+        __attribute__((target("ssse3"))) static inline void
+        muladd(uint8_t* dst, const uint8_t* src, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            auto lo     = _mm_load_si128(reinterpret_cast<const __m128i*>(split.lo));
+            auto hi     = _mm_load_si128(reinterpret_cast<const __m128i*>(split.hi));
+            auto mask   = _mm_set1_epi8(0x0F);
+            for (; len >= 16; len -= 16, dst += 16, src += 16) {
+                auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                auto y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                auto l = _mm_shuffle_epi8(lo, _mm_and_si128(x, mask));
+                auto h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(x, 4), mask));
+                _mm_storeu_si128(
+                  reinterpret_cast<__m128i*>(dst), _mm_xor_si128(y, _mm_xor_si128(l, h)));
+            }
+            for (; len; --len, ++dst, ++src)
+                *dst ^= split(*src);
+        }
+    } // namespace ssse3
+
+    /// -------------------------------------------------------------------------------------------
+    /// avx2
+    /// -------------------------------------------------------------------------------------------
+    namespace avx2 {
+        static inline bool supported() { return __builtin_cpu_supports("avx2"); }
+
+        __attribute__((target("avx2"))) static inline void
+        mul(uint8_t* dst, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            auto lo     = _mm256_broadcastsi128_si256(
+              _mm_load_si128(reinterpret_cast<const __m128i*>(split.lo)));
+            auto hi = _mm256_broadcastsi128_si256(
+              _mm_load_si128(reinterpret_cast<const __m128i*>(split.hi)));
+            auto mask = _mm256_set1_epi8(0x0F);
+            for (; len >= 32; len -= 32, dst += 32) {
+                auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+                auto l = _mm256_shuffle_epi8(lo, _mm256_and_si256(x, mask));
+                auto h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_xor_si256(l, h));
+            }
+            for (; len; --len, ++dst)
+                *dst = split(*dst);
+        }
+
+        __attribute__((target("avx2"))) static inline void
+        sum(uint8_t* dst, const uint8_t* src, size_t len) {
+            for (; len >= 32; len -= 32, dst += 32, src += 32) {
+                auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+                auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_xor_si256(a, b));
+            }
+            scalar::sum(dst, src, len);
+        }
+
+        __attribute__((target("avx2"))) static inline void
+        muladd(uint8_t* dst, const uint8_t* src, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            auto lo     = _mm256_broadcastsi128_si256(
+              _mm_load_si128(reinterpret_cast<const __m128i*>(split.lo)));
+            auto hi = _mm256_broadcastsi128_si256(
+              _mm_load_si128(reinterpret_cast<const __m128i*>(split.hi)));
+            auto mask = _mm256_set1_epi8(0x0F);
+            for (; len >= 32; len -= 32, dst += 32, src += 32) {
+                auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+                auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+                auto l = _mm256_shuffle_epi8(lo, _mm256_and_si256(x, mask));
+                auto h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask));
+                _mm256_storeu_si256(
+                  reinterpret_cast<__m256i*>(dst), _mm256_xor_si256(y, _mm256_xor_si256(l, h)));
+            }
+            for (; len; --len, ++dst, ++src)
+                *dst ^= split(*src);
+        }
+    } // namespace avx2
+
+    /// -------------------------------------------------------------------------------------------
+    /// avx512
+    /// -------------------------------------------------------------------------------------------
+    namespace avx512 {
+        static inline bool supported() {
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) static inline void
+        mul(uint8_t* dst, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            // one copy of the tables per 128 bit lane
+            alignas(64) uint8_t tables[2][64];
+            for (unsigned i = 0; i < 64; i += 16) {
+                std::memcpy(&tables[0][i], split.lo, 16);
+                std::memcpy(&tables[1][i], split.hi, 16);
+            }
+            auto lo   = _mm512_load_si512(tables[0]);
+            auto hi   = _mm512_load_si512(tables[1]);
+            auto mask = _mm512_set1_epi8(0x0F);
+            for (; len >= 64; len -= 64, dst += 64) {
+                auto x = _mm512_loadu_si512(dst);
+                auto l = _mm512_shuffle_epi8(lo, _mm512_and_si512(x, mask));
+                auto h = _mm512_shuffle_epi8(hi, _mm512_and_si512(_mm512_srli_epi16(x, 4), mask));
+                _mm512_storeu_si512(dst, _mm512_xor_si512(l, h));
+            }
+            for (; len; --len, ++dst)
+                *dst = split(*dst);
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) static inline void
+        sum(uint8_t* dst, const uint8_t* src, size_t len) {
+            for (; len >= 64; len -= 64, dst += 64, src += 64) {
+                auto a = _mm512_loadu_si512(dst);
+                auto b = _mm512_loadu_si512(src);
+                _mm512_storeu_si512(dst, _mm512_xor_si512(a, b));
+            }
+            scalar::sum(dst, src, len);
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) static inline void
+        muladd(uint8_t* dst, const uint8_t* src, size_t len, uint8_t m) {
+            auto& split = SPLIT[m];
+            // one copy of the tables per 128 bit lane
+            alignas(64) uint8_t tables[2][64];
+            for (unsigned i = 0; i < 64; i += 16) {
+                std::memcpy(&tables[0][i], split.lo, 16);
+                std::memcpy(&tables[1][i], split.hi, 16);
+            }
+            auto lo   = _mm512_load_si512(tables[0]);
+            auto hi   = _mm512_load_si512(tables[1]);
+            auto mask = _mm512_set1_epi8(0x0F);
+            for (; len >= 64; len -= 64, dst += 64, src += 64) {
+                auto x = _mm512_loadu_si512(src);
+                auto y = _mm512_loadu_si512(dst);
+                auto l = _mm512_shuffle_epi8(lo, _mm512_and_si512(x, mask));
+                auto h = _mm512_shuffle_epi8(hi, _mm512_and_si512(_mm512_srli_epi16(x, 4), mask));
+                _mm512_storeu_si512(dst, _mm512_xor_si512(y, _mm512_xor_si512(l, h)));
+            }
+            for (; len; --len, ++dst, ++src)
+                *dst ^= split(*src);
+        }
+    } // namespace avx512
+
+    /// -------------------------------------------------------------------------------------------
+    /// gfni
+    /// @brief gf2p8mulb is fixed to the AES polynomial (0x11B), so the product by a constant is
+    ///        applied as a gf2p8affineqb bit matrix built for this field
+    /// -------------------------------------------------------------------------------------------
+    namespace gfni {
+        static inline bool supported() {
+            return __builtin_cpu_supports("gfni") && __builtin_cpu_supports("avx2");
+        }
+
+        __attribute__((target("gfni,avx2"))) static inline void
+        mul(uint8_t* dst, size_t len, uint8_t m) {
+            auto matrix = _mm256_set1_epi64x(int64_t(AFFINE[m]));
+            for (; len >= 32; len -= 32, dst += 32) {
+                auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+                _mm256_storeu_si256(
+                  reinterpret_cast<__m256i*>(dst), _mm256_gf2p8affine_epi64_epi8(x, matrix, 0));
+            }
+            scalar::mul(dst, len, m);
+        }
+
+        __attribute__((target("gfni,avx2"))) static inline void
+        muladd(uint8_t* dst, const uint8_t* src, size_t len, uint8_t m) {
+            auto matrix = _mm256_set1_epi64x(int64_t(AFFINE[m]));
+            for (; len >= 32; len -= 32, dst += 32, src += 32) {
+                auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+                auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+                _mm256_storeu_si256(
+                  reinterpret_cast<__m256i*>(dst),
+                  _mm256_xor_si256(y, _mm256_gf2p8affine_epi64_epi8(x, matrix, 0)));
+            }
+            scalar::muladd(dst, src, len, m);
+        }
+    } // namespace gfni
+#endif
+
+    /// Kernels (ordered by preference)
+    inline const auto KERNELS = std::array{
+#ifdef SHARE_CODEC_X86
+      Kernel{"gfni", gfni::supported, gfni::mul, avx2::sum, gfni::muladd},
+      Kernel{"avx512", avx512::supported, avx512::mul, avx512::sum, avx512::muladd},
+      Kernel{"avx2", avx2::supported, avx2::mul, avx2::sum, avx2::muladd},
+      Kernel{"ssse3", ssse3::supported, ssse3::mul, ssse3::sum, ssse3::muladd},
+#endif
+      Kernel{"scalar", scalar::supported, scalar::mul, scalar::sum, scalar::muladd}};
+
+    /// get
+    /// @brief best kernel supported by this cpu (selected once)
+    inline const Kernel& get() {
+        static const Kernel& kernel = []() -> const Kernel& {
+            for (auto& k : KERNELS)
+                if (k.supported())
+                    return k;
+            return KERNELS.back();
+        }();
+        return kernel;
+    }
+} // namespace gf8::kernel
+} // namespace share::codec::helpers
@@ -0,0 +1,240 @@
+/// ===============================================================================================
+/// @file      : matrix.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace share::codec::helpers {
+
+/// slab alignment (and row stride granularity)
+static constexpr size_t MATRIX_ALIGNMENT = 64;
+
+/// row
+/// @brief
+/// handle of a matrix row, swapping or rotating handles reorders the matrix
+/// without moving the row contents
+class row {
+  public:
+    using value_type     = uint8_t;
+    using iterator       = uint8_t*;
+    using const_iterator = const uint8_t*;
+
+    /// constructors
+    row() : data_{nullptr}, size_{0} {}
+    row(uint8_t* data, size_t size) : data_{data}, size_{size} {}
+
+    /// iterators
+    auto begin() { return data_; }
+    auto end() { return data_ + size_; }
+    auto begin() const { return static_cast<const uint8_t*>(data_); }
+    auto end() const { return static_cast<const uint8_t*>(data_ + size_); }
+
+    /// access
+    auto data() { return data_; }
+    auto data() const { return static_cast<const uint8_t*>(data_); }
+    auto& operator[](size_t n) { return data_[n]; }
+    auto& operator[](size_t n) const { return static_cast<const uint8_t&>(data_[n]); }
+
+    /// quantity
+    auto size() const { return size_; }
+    auto empty() const { return size_ == 0; }
+
+  private:
+    uint8_t* data_;
+    size_t size_;
+};
+
+/// matrix
+/// @brief
+/// rows of a single 64 byte aligned slab with a padded stride, rows are addressed through
+/// a permutation of handles (cheap swaps) and the slab only grows when the reserve is exceeded
+class matrix {
+  public:
+    using value_type     = row;
+    using iterator       = std::vector<row>::iterator;
+    using const_iterator = std::vector<row>::const_iterator;
+
+    /// constructors
+    matrix() : matrix(0, 0) {}
+
+    /// constructor
+    /// @param rows    initial rows (zero)
+    /// @param cols    row size
+    /// @param reserve rows allocated in the slab
+    matrix(size_t rows, size_t cols, size_t reserve = 0)
+      : slab_{nullptr, release},
+        rows_{},
+        free_{},
+        cols_{cols},
+        stride_{(cols + MATRIX_ALIGNMENT - 1) & ~(MATRIX_ALIGNMENT - 1)},
+        capacity_{},
+        used_{} {
+        this->reserve(std::max(rows, reserve));
+        resize(rows);
+    }
+
+    /// copy constructor
+    matrix(const matrix& other) : matrix(0, other.cols_, other.rows_.size()) {
+        for (auto& r : other.rows_)
+            push_back(r);
+    }
+
+    /// move constructor
+    matrix(matrix&&) = default;
+
+    /// operators
+    matrix& operator=(matrix&&) = default;
+    matrix& operator=(const matrix& other) {
+        if (this != &other)
+            *this = matrix(other);
+        return *this;
+    }
+
+    /// iterators
+    auto begin() { return rows_.begin(); }
+    auto end() { return rows_.end(); }
+    auto begin() const { return rows_.begin(); }
+    auto end() const { return rows_.end(); }
+
+    /// references
+    auto& operator[](size_t n) { return rows_[n]; }
+    auto& operator[](size_t n) const { return rows_[n]; }
+    auto& at(size_t n) { return rows_.at(n); }
+    auto& at(size_t n) const { return rows_.at(n); }
+    auto& front() { return rows_.front(); }
+    auto& front() const { return rows_.front(); }
+    auto& back() { return rows_.back(); }
+    auto& back() const { return rows_.back(); }
+
+    /// quantity
+    auto size() const { return rows_.size(); }
+    auto empty() const { return rows_.empty(); }
+    auto cols() const { return cols_; }
+    auto stride() const { return stride_; }
+    auto capacity() const { return capacity_; }
+    /// slab bytes
+    auto memory() const { return capacity_ * stride_; }
+
+    /// push back
+    /// @brief append a row with the contents of vector (truncated or zero filled)
+    /// @param vector
+    template <typename Vector>
+    void push_back(const Vector& vector) {
+        auto ptr = slot();
+        auto len = std::min(size_t(vector.size()), cols_);
+        std::copy_n(std::begin(vector), len, ptr);
+        std::fill(ptr + len, ptr + stride_, uint8_t{0});
+        rows_.emplace_back(ptr, cols_);
+    }
+
+    /// push back
+    /// @brief append a zero row
+    void push_back() {
+        auto ptr = slot();
+        std::fill(ptr, ptr + stride_, uint8_t{0});
+        rows_.emplace_back(ptr, cols_);
+    }
+
+    /// pop back
+    void pop_back() {
+        free_.push_back(rows_.back().data());
+        rows_.pop_back();
+    }
+
+    /// resize
+    /// @param rows
+    void resize(size_t rows) {
+        while (rows_.size() > rows)
+            pop_back();
+        while (rows_.size() < rows)
+            push_back();
+    }
+
+    /// clear
+    void clear() {
+        rows_.clear();
+        free_.clear();
+        used_ = 0;
+    }
+
+    /// reshape
+    /// @brief clear and change the row size, the slab is kept when it is large enough
+    /// @param rows zero rows
+    /// @param cols
+    void reshape(size_t rows, size_t cols) {
+        clear();
+        auto bytes = capacity_ * stride_;
+        cols_      = cols;
+        stride_    = (cols + MATRIX_ALIGNMENT - 1) & ~(MATRIX_ALIGNMENT - 1);
+        capacity_  = stride_ ? bytes / stride_ : capacity_;
+        reserve(rows);
+        resize(rows);
+    }
+
+    /// reserve
+    /// @param rows
+    void reserve(size_t rows) {
+        if (rows <= capacity_)
+            return;
+        auto slab = allocate(rows * stride_);
+        // compact the rows in handle order
+        auto ptr = slab.get();
+        for (auto& r : rows_) {
+            std::copy_n(r.data(), stride_, ptr);
+            r = row(ptr, cols_);
+            ptr += stride_;
+        }
+        free_.clear();
+        used_     = rows_.size();
+        capacity_ = rows;
+        slab_     = std::move(slab);
+        rows_.reserve(rows);
+    }
+
+  private:
+    using slab = std::unique_ptr<uint8_t[], void (*)(uint8_t*)>;
+
+    /// storage
+    slab slab_;
+    std::vector<row> rows_;
+    std::vector<uint8_t*> free_;
+
+    /// context
+    size_t cols_;
+    size_t stride_;
+    size_t capacity_;
+    size_t used_;
+
+    /// slot
+    /// @brief storage of a new row
+    uint8_t* slot() {
+        if (!free_.empty()) {
+            auto ptr = free_.back();
+            free_.pop_back();
+            return ptr;
+        }
+        if (used_ == capacity_)
+            reserve(std::max(capacity_ * 2, size_t{4}));
+        return slab_.get() + (used_++ * stride_);
+    }
+
+    /// aligned slab
+    static slab allocate(size_t size) {
+        auto ptr = ::operator new[](std::max(size, size_t{1}), std::align_val_t{MATRIX_ALIGNMENT});
+        return slab(static_cast<uint8_t*>(ptr), release);
+    }
+    static void release(uint8_t* ptr) {
+        ::operator delete[](ptr, std::align_val_t{MATRIX_ALIGNMENT});
+    }
+};
+} // namespace share::codec::helpers
@@ -0,0 +1,166 @@
+/// ===============================================================================================
+/// @file      : parallel.hpp                                              |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace share::codec::helpers {
+
+/// parallel
+/// @brief
+/// fork-join worker pool that splits a range of columns in stripes,
+/// small workloads (below the threshold) run on the calling thread
+class parallel {
+  public:
+    static constexpr size_t DEFAULT_STRIPE    = size_t{1} << 16;
+    static constexpr size_t DEFAULT_THRESHOLD = size_t{1} << 22;
+
+    /// constructor
+    /// @param threads   number of threads (calling thread included)
+    /// @param stripe    column stripe width
+    /// @param threshold minimum workload (bytes) to go parallel
+    explicit parallel(
+      size_t threads   = std::thread::hardware_concurrency(),
+      size_t stripe    = DEFAULT_STRIPE,
+      size_t threshold = DEFAULT_THRESHOLD)
+      : workers_{},
+        mutex_{},
+        wake_{},
+        idle_{},
+        batch_{},
+        generation_{},
+        stop_{},
+        stripe_{std::max(stripe & ~size_t{63}, size_t{64})},
+        threshold_{threshold} {
+        for (size_t i = 1; i < threads; ++i)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    /// destructor
+    ~parallel() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    /// properties
+    auto threads() const { return workers_.size() + 1; }
+    auto stripe() const { return stripe_; }
+    auto threshold() const { return threshold_; }
+
+    /// run
+    /// @brief call function(offset, length) for each stripe of [0, length)
+    /// @param length   columns
+    /// @param workload estimated bytes touched
+    /// @param function
+    template <typename Function>
+    void run(size_t length, size_t workload, Function&& function) {
+        if (workers_.empty() || workload < threshold_ || length <= stripe_) {
+            function(size_t{0}, length);
+            return;
+        }
+        submit((length + stripe_ - 1) / stripe_, [this, length, &function](size_t n) {
+            auto offset = n * stripe_;
+            function(offset, std::min(stripe_, length - offset));
+        });
+    }
+
+    /// each
+    /// @brief call function(index) for each index of [0, count) (one task per index)
+    /// @param count
+    /// @param function
+    template <typename Function>
+    void each(size_t count, Function&& function) {
+        if (workers_.empty() || count <= 1) {
+            for (size_t n = 0; n < count; ++n)
+                function(n);
+            return;
+        }
+        submit(count, [&function](size_t n) { function(n); });
+    }
+
+  private:
+    /// submit
+    /// @brief run job(n) for n in [0, total) on the workers and the calling thread
+    void submit(size_t total, std::function<void(size_t)> job) {
+        // new batch
+        auto batch   = std::make_shared<Batch>();
+        batch->total = total;
+        batch->job   = std::move(job);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batch_ = batch;
+            ++generation_;
+        }
+        wake_.notify_all();
+        // join the work
+        drain(*batch);
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [&batch]() { return batch->done == batch->total; });
+    }
+
+    /// batch of stripes
+    struct Batch {
+        std::function<void(size_t)> job;
+        size_t total;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+
+    /// workers
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::shared_ptr<Batch> batch_;
+    size_t generation_;
+    bool stop_;
+
+    /// properties
+    size_t stripe_;
+    size_t threshold_;
+
+    /// drain
+    void drain(Batch& batch) {
+        for (auto n = batch.next++; n < batch.total; n = batch.next++) {
+            batch.job(n);
+            if (++batch.done == batch.total) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                idle_.notify_all();
+            }
+        }
+    }
+
+    /// work
+    void work() {
+        auto seen = size_t{0};
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, &seen]() { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen       = generation_;
+            auto batch = batch_;
+            lock.unlock();
+            drain(*batch);
+        }
+    }
+};
+} // namespace share::codec::helpers
@@ -0,0 +1,130 @@
+/// ===============================================================================================
+/// @file      : program.hpp                                               |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gf8.hpp"
+#include "stats.hpp"
+
+namespace share::codec::helpers {
+
+/// none
+/// @brief no payload (coefficient only operations)
+struct none {};
+
+/// program
+/// @brief
+/// payload row operations recorded while the coefficients are reduced,
+/// replayed afterwards over whole rows or over independent column stripes
+class program {
+  public:
+    /// operation (dst = dst * factor) when src is MUL, (dst += src * factor) otherwise
+    struct operation {
+        size_t dst;
+        size_t src;
+        uint8_t factor;
+    };
+    static constexpr size_t MUL = ~size_t{0};
+
+    /// record
+    void mul(size_t row, uint8_t factor) {
+        if (factor != 1)
+            ops_.push_back({row_(row), MUL, factor});
+    }
+    void muladd(size_t dst, size_t src, uint8_t factor) {
+        if (factor != 0)
+            ops_.push_back({row_(dst), row_(src), factor});
+    }
+    void swap(size_t a, size_t b) {
+        for (auto n = std::max(a, b); perm_.size() <= n;)
+            perm_.push_back(perm_.size());
+        std::swap(perm_[a], perm_[b]);
+    }
+
+    /// quantity
+    auto size() const { return ops_.size(); }
+    auto empty() const { return ops_.empty() && perm_.empty(); }
+    void clear() {
+        ops_.clear();
+        perm_.clear();
+    }
+
+    /// run
+    /// @brief replay on the columns [offset, offset + length) of data
+    template <typename Matrix>
+    void run(Matrix& data, size_t offset, size_t length) const {
+        for (auto& op : ops_) {
+            uint8_t* dst = data[op.dst].data() + offset;
+            if (op.src == MUL) {
+                gf8::mul(dst, length, op.factor);
+                continue;
+            }
+            const uint8_t* src = data[op.src].data() + offset;
+            gf8::muladd(dst, src, length, op.factor);
+        }
+    }
+
+    /// permute
+    /// @brief move rows to the order left by the recorded swaps
+    template <typename Matrix>
+    void permute(Matrix& data) const {
+        if (perm_.empty())
+            return;
+        auto rows = std::vector<typename Matrix::value_type>(perm_.size());
+        for (size_t i = 0; i < perm_.size(); ++i)
+            rows[i] = std::move(data[perm_[i]]);
+        for (size_t i = 0; i < perm_.size(); ++i)
+            data[i] = std::move(rows[i]);
+    }
+
+  private:
+    std::vector<operation> ops_;
+    std::vector<size_t> perm_;
+
+    size_t row_(size_t row) const { return row < perm_.size() ? perm_[row] : row; }
+};
+
+/// rows
+/// @brief payload row operations, applied at once on a matrix,
+///        recorded on a program or skipped on none (the callers count the bytes once per
+///        reduction with length, a program counts its bytes when run)
+namespace rows {
+    template <typename Matrix>
+    static inline void mul(Matrix& data, size_t row, uint8_t factor) {
+        gf8::mul(data[row], factor);
+    }
+    template <typename Matrix>
+    static inline void muladd(Matrix& data, size_t dst, size_t src, uint8_t factor) {
+        gf8::muladd(data[dst], data[src], factor);
+    }
+    template <typename Matrix>
+    static inline size_t length(const Matrix& data) {
+        return data.empty() ? 0 : data[0].size();
+    }
+    template <typename Matrix>
+    static inline void swap(Matrix& data, size_t a, size_t b) {
+        std::swap(data[a], data[b]);
+    }
+
+    static inline void mul(program& prog, size_t row, uint8_t factor) { prog.mul(row, factor); }
+    static inline void muladd(program& prog, size_t dst, size_t src, uint8_t factor) {
+        prog.muladd(dst, src, factor);
+    }
+    static inline void swap(program& prog, size_t a, size_t b) { prog.swap(a, b); }
+    static inline size_t length(const program&) { return 0; }
+
+    static inline void mul(none&, size_t, uint8_t) {}
+    static inline void muladd(none&, size_t, size_t, uint8_t) {}
+    static inline void swap(none&, size_t, size_t) {}
+    static inline size_t length(const none&) { return 0; }
+} // namespace rows
+} // namespace share::codec::helpers
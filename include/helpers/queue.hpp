@@ -0,0 +1,111 @@
+/// ===============================================================================================
+/// @file      : queue.hpp                                                 |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace share::codec::helpers {
+
+/// queue
+/// @brief
+/// bounded lock-free ring (multiple producers, multiple consumers), each cell carries a
+/// sequence number that tells whether it is free for the producer or ready for the consumer
+/// of a position, the cells are allocated once, values are moved in and out
+template <typename T>
+class queue {
+  public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    /// constructor
+    /// @param capacity rounded up to a power of two
+    explicit queue(size_t capacity = DEFAULT_CAPACITY)
+      : cells_{}, mask_{round(capacity) - 1}, head_{0}, tail_{0} {
+        cells_ = std::make_unique<cell[]>(mask_ + 1);
+        for (size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// push
+    /// @param value moved in on success, untouched when the ring is full
+    /// @return false when the ring is full
+    bool push(T& value) {
+        auto pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& c   = cells_[pos & mask_];
+            auto seq  = c.sequence.load(std::memory_order_acquire);
+            auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = std::move(value);
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// pop
+    /// @param value moved out on success
+    /// @return false when the ring is empty
+    bool pop(T& value) {
+        auto pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& c   = cells_[pos & mask_];
+            auto seq  = c.sequence.load(std::memory_order_acquire);
+            auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(c.value);
+                    c.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// quantity (approximate while producers or consumers are active)
+    size_t size() const {
+        auto tail = tail_.load(std::memory_order_acquire);
+        auto head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+  private:
+    /// cell
+    struct cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<cell[]> cells_;
+    size_t mask_;
+    /// positions (own cache lines, producers and consumer do not share them)
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+
+    static size_t round(size_t n) {
+        auto out = size_t{2};
+        while (out < n)
+            out <<= 1;
+        return out;
+    }
+};
+} // namespace share::codec::helpers
@@ -7,71 +7,77 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <numeric>
 #include <type_traits>
+#include <vector>
 
+#include "binary.hpp"
+#include "combine.hpp"
 #include "gf8.hpp"
+#include "parallel.hpp"
+#include "program.hpp"
+#include "stats.hpp"
 
 namespace share::codec::helpers {
 
 namespace {
-    template <typename Matrix>
-    static inline void elimination(Matrix& coef, Matrix& data, size_t index) {
-        for (uint32_t i = index + 1; i < data.size(); ++i) {
+    template <typename Matrix, typename Data>
+    static inline void elimination(Matrix& coef, Data& data, size_t index) {
+        [[maybe_unused]] auto ops = size_t{0};
+        for (uint32_t i = index + 1; i < coef.size(); ++i) {
             if (coef[i][index] == 0) {
                 continue;
             }
             // compute factor
-            auto factor = gf8::div(coef[index][index], coef[i][index]);
-            // verify factor
-            if (factor == 1) {
-                gf8::sum(coef[i], coef[index], index);
-                gf8::sum(data[i], data[index]);
-                continue;
-            }
-            // multiply and sum
-            gf8::sum(gf8::mul(coef[i], factor, index), coef[index], index);
-            gf8::sum(gf8::mul(data[i], factor), data[index]);
+            auto factor = gf8::div(coef[i][index], coef[index][index]);
+            // multiply and sum (Ri += Rn * F)
+            gf8::muladd(coef[i], coef[index], factor, index);
+            rows::muladd(data, i, index, factor);
+            ++ops;
         }
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+        CODEC_SHARE_COUNT(
+          stats::current(), BYTES, ops * (coef[index].size() - index + rows::length(data)));
     }
 
-    template <typename Matrix>
-    static inline bool prepare(Matrix& coef, Matrix& data, size_t index) {
+    template <typename Matrix, typename Data>
+    static inline bool prepare(Matrix& coef, Data& data, size_t index) {
         if (coef[index][index]) {
             return true;
         }
-        for (int i = index + 1, ii = int(data.size()); i < ii; ++i) {
+        for (int i = index + 1, ii = int(coef.size()); i < ii; ++i) {
             if (coef[i][index]) {
                 std::swap(coef[index], coef[i]);
-                std::swap(data[index], data[i]);
+                rows::swap(data, index, i);
                 return true;
             }
         }
         return false;
     }
 
-    template <typename Matrix>
-    static inline void reverse_elimination(Matrix& coef, Matrix& data, size_t index) {
+    template <typename Matrix, typename Data>
+    static inline void reverse_elimination(Matrix& coef, Data& data, size_t index) {
+        [[maybe_unused]] auto ops = size_t{0};
         for (auto i = size_t{0}; i < index; ++i) {
             if (coef[i][index] == 0) {
                 continue;
             }
             // compute factor
             auto factor = gf8::div(coef[i][index], coef[index][index]);
-            // verify factor
-            if (factor == 1) {
-                gf8::sum(coef[i], coef[index], index);
-                gf8::sum(data[i], data[index]);
-                continue;
-            }
-            // multiply and sum (= merge)
-            gf8::sum(coef[i], gf8::mul(coef[index], factor, index), index);
-            gf8::sum(data[i], gf8::mul(data[index], factor));
+            // multiply and sum (Ri += Rn * F)
+            gf8::muladd(coef[i], coef[index], factor, index);
+            rows::muladd(data, i, index, factor);
+            ++ops;
         }
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+        CODEC_SHARE_COUNT(
+          stats::current(), BYTES, ops * (coef[index].size() - index + rows::length(data)));
     }
 
-    template <typename Matrix>
-    static inline void unification(Matrix& coef, Matrix& data, int index) {
+    template <typename Matrix, typename Data>
+    static inline void unification(Matrix& coef, Data& data, int index) {
         auto factor = gf8::div(std::decay_t<decltype(coef[index][index])>(1), coef[index][index]);
         if (factor == 0) {
             return;
@@ -79,54 +85,324 @@ namespace {
         if (factor == 1) {
             return;
         }
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, 1);
+        CODEC_SHARE_COUNT(
+          stats::current(), BYTES, coef[index].size() - index + rows::length(data));
         gf8::mul(coef[index], factor, index);
-        gf8::mul(data[index], factor);
+        rows::mul(data, index, factor);
     }
 
-    template <typename Vector, typename Matrix>
-    static inline void organize(Vector& field, Matrix& coef, Matrix& data) {
-        if (field.empty()) {
-            return;
+    /// reorder
+    /// @brief move the rows to the given order (row order[k] to position k), the rows are
+    ///        moved by exchange(i, j) swaps
+    template <typename Exchange>
+    static inline void reorder(const std::vector<size_t>& order, Exchange&& exchange) {
+        auto n     = order.size();
+        auto where = std::vector<size_t>(n);
+        auto at    = std::vector<size_t>(n);
+        std::iota(std::begin(where), std::end(where), size_t{0});
+        std::iota(std::begin(at), std::end(at), size_t{0});
+        for (size_t k = 0; k < n; ++k) {
+            auto i = where[order[k]];
+            if (i == k)
+                continue;
+            exchange(i, k);
+            std::swap(at[i], at[k]);
+            where[at[i]] = i;
+            where[at[k]] = k;
+        }
+    }
+
+    /// organize
+    /// @brief stable partition, binary rows (field 1) first
+    template <typename Vector, typename Matrix, typename Data>
+    static inline void organize(Vector& field, Matrix& coef, Data& data) {
+        auto order = std::vector<size_t>(std::min(field.size(), coef.size()));
+        std::iota(std::begin(order), std::end(order), size_t{0});
+        std::stable_partition(
+          std::begin(order), std::end(order), [&](size_t i) { return field[i] == 1; });
+        reorder(order, [&](size_t i, size_t j) {
+            std::swap(field[i], field[j]);
+            std::swap(coef[i], coef[j]);
+            rows::swap(data, i, j);
+        });
+    }
+
+    /// mixed
+    /// @brief
+    /// the binary rows [0, b) are eliminated bit packed (xor, no multiplication), the other
+    /// rows are reduced against them and solved over GF(2^8) on the columns left, the rows
+    /// are left sorted by pivot column (identity at full rank)
+    template <typename Matrix, typename Data>
+    static inline size_t mixed(size_t size, size_t b, Matrix& coef, Data& data) {
+        auto m      = coef.size();
+        auto cols   = coef[0].size();
+        auto words  = bits::words(cols);
+        auto packed = std::vector<uint64_t>(b * words);
+        auto bit    = [&](size_t i) { return packed.data() + i * words; };
+        auto pivots = std::vector<size_t>();
+        auto taken  = std::vector<bool>(cols, false);
+        [[maybe_unused]] auto ops = size_t{0};
+        for (size_t i = 0; i < b; ++i)
+            bits::pack(coef[i].data(), cols, bit(i));
+        // binary forward elimination
+        auto r = size_t{0};
+        {
+            CODEC_SHARE_PHASE(stats::current(), FORWARD);
+            for (size_t c = 0; c < size && r < b; ++c) {
+                auto i = r;
+                while (i < b && !bits::test(bit(i), c))
+                    ++i;
+                if (i == b)
+                    continue;
+                if (i != r) {
+                    std::swap(coef[i], coef[r]);
+                    std::swap_ranges(bit(i), bit(i) + words, bit(r));
+                    rows::swap(data, i, r);
+                }
+                for (auto j = r + 1; j < b; ++j) {
+                    if (!bits::test(bit(j), c))
+                        continue;
+                    bits::add(bit(j), bit(r), c, cols);
+                    rows::muladd(data, j, r, 1);
+                    ++ops;
+                }
+                pivots.push_back(c);
+                taken[c] = true;
+                ++r;
+            }
+        }
+        // binary backward elimination and unpack
+        {
+            CODEC_SHARE_PHASE(stats::current(), BACKWARD);
+            for (auto t = r; t-- > 0;) {
+                for (size_t j = 0; j < t; ++j) {
+                    if (!bits::test(bit(j), pivots[t]))
+                        continue;
+                    bits::add(bit(j), bit(t), pivots[t], cols);
+                    rows::muladd(data, j, t, 1);
+                    ++ops;
+                }
+            }
+            for (size_t i = 0; i < b; ++i)
+                bits::unpack(bit(i), cols, coef[i].data());
+        }
+        // GF(2^8) rows, binary pivots removed (a sum of the factor on the set bits)
+        {
+            CODEC_SHARE_PHASE(stats::current(), FORWARD);
+            for (auto i = b; i < m; ++i) {
+                for (size_t t = 0; t < r; ++t) {
+                    auto factor = coef[i][pivots[t]];
+                    if (factor == 0)
+                        continue;
+                    bits::scatter(bit(t), cols, factor, coef[i].data());
+                    rows::muladd(data, i, t, factor);
+                    ++ops;
+                }
+            }
+        }
+        // GF(2^8) forward elimination on the columns left (rows [r, m), dependent binary
+        // rows are zero and never chosen)
+        auto q = r;
+        {
+            CODEC_SHARE_PHASE(stats::current(), FORWARD);
+            for (size_t c = 0; c < size && q < m; ++c) {
+                if (taken[c])
+                    continue;
+                auto i = q;
+                while (i < m && coef[i][c] == 0)
+                    ++i;
+                if (i == m)
+                    continue;
+                if (i != q) {
+                    std::swap(coef[i], coef[q]);
+                    rows::swap(data, i, q);
+                }
+                for (auto j = q + 1; j < m; ++j) {
+                    if (coef[j][c] == 0)
+                        continue;
+                    auto factor = gf8::div(coef[j][c], coef[q][c]);
+                    gf8::muladd(coef[j], coef[q], factor, c);
+                    rows::muladd(data, j, q, factor);
+                    ++ops;
+                }
+                pivots.push_back(c);
+                ++q;
+            }
         }
-        for (auto i = size_t(0), ii = field.size() - 1; i < ii;) {
-            if (field[i] == 1) {
-                i++;
-                if (field[ii] != 1) {
-                    ii--;
+        // GF(2^8) diagonal unification and backward elimination (binary rows included)
+        {
+            CODEC_SHARE_PHASE(stats::current(), BACKWARD);
+            for (auto s = q; s-- > r;) {
+                auto c      = pivots[s];
+                auto factor = gf8::div(1, coef[s][c]);
+                if (factor != 1) {
+                    gf8::mul(coef[s], factor, c);
+                    rows::mul(data, s, factor);
+                    ++ops;
                 }
-            } else {
-                if (field[ii] == 1) {
-                    std::swap(field[i], field[ii]);
-                    std::swap(coef[i], coef[ii]);
-                    std::swap(data[i], data[ii]);
-                    i++;
+                for (size_t j = 0; j < s; ++j) {
+                    if (coef[j][c] == 0)
+                        continue;
+                    factor = coef[j][c];
+                    gf8::muladd(coef[j], coef[s], factor, c);
+                    rows::muladd(data, j, s, factor);
+                    ++ops;
                 }
-                ii--;
             }
         }
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+        CODEC_SHARE_COUNT(stats::current(), BYTES, ops * rows::length(data));
+        // rows sorted by pivot column
+        auto order = std::vector<size_t>(q);
+        std::iota(std::begin(order), std::end(order), size_t{0});
+        std::sort(std::begin(order), std::end(order), [&](size_t x, size_t y) {
+            return pivots[x] < pivots[y];
+        });
+        reorder(order, [&](size_t i, size_t j) {
+            std::swap(coef[i], coef[j]);
+            rows::swap(data, i, j);
+        });
+        // solved leading columns
+        auto n = size_t{0};
+        while (n < q && pivots[order[n]] == n)
+            ++n;
+        return n;
     }
 } // namespace
 
 /// solve
 /// @brief 
-/// solve gf8 combination system
-template <typename Vector, typename Matrix>
-static size_t solve(size_t size, Vector& field, Matrix& coef, Matrix& data) {
+/// solve gf8 combination system, the binary rows (field 1) are solved first bit packed
+/// and the GF(2^8) rows only on the columns they leave
+template <typename Vector, typename Matrix, typename Data>
+static size_t solve(size_t size, Vector& field, Matrix& coef, Data& data) {
     size_t n = 0;
     // organize data
     organize(field, coef, data);
+    // binary subsystem first
+    auto b = size_t{0};
+    while (b < field.size() && b < coef.size() && field[b] == 1)
+        ++b;
+    if (b > 0) {
+        n = mixed(size, b, coef, data);
+        CODEC_SHARE_SET(stats::current(), RANK, n);
+        return n;
+    }
     // forward elemination
-    for (; n < size && n < data.size(); ++n) {
-        if (!prepare(coef, data, n))
-            break;
-        elimination(coef, data, n);
+    {
+        CODEC_SHARE_PHASE(stats::current(), FORWARD);
+        for (; n < size && n < coef.size(); ++n) {
+            if (!prepare(coef, data, n))
+                break;
+            elimination(coef, data, n);
+        }
     }
     // backward elemination
-    for (size_t i = 0; i < n; ++i)
-        reverse_elimination(coef, data, i);
+    {
+        CODEC_SHARE_PHASE(stats::current(), BACKWARD);
+        for (size_t i = 0; i < n; ++i)
+            reverse_elimination(coef, data, i);
+    }
     // diagonal unification
-    for (size_t i = 0; i < n; ++i)
-        unification(coef, data, i);
+    {
+        CODEC_SHARE_PHASE(stats::current(), UNIFY);
+        for (size_t i = 0; i < n; ++i)
+            unification(coef, data, i);
+    }
+    CODEC_SHARE_SET(stats::current(), RANK, n);
+    return n;
+}
+
+/// solve
+/// @brief
+/// solve gf8 combination system, the coefficients are solved first and the recorded
+/// payload operations are replayed over column stripes on the parallel workers
+template <typename Vector, typename Matrix, typename Data>
+static size_t solve(size_t size, Vector& field, Matrix& coef, Data& data, parallel& workers) {
+    auto prog = program{};
+    auto n    = solve(size, field, coef, prog);
+    if (!data.empty()) {
+        CODEC_SHARE_PHASE(stats::current(), PAYLOAD);
+        auto length = data.front().size();
+        CODEC_SHARE_COUNT(stats::current(), BYTES, prog.size() * length);
+        workers.run(length, prog.size() * length, [&](size_t offset, size_t len) {
+            prog.run(data, offset, len);
+        });
+    }
+    prog.permute(data);
     return n;
 }
+
+/// not innovative row
+static constexpr size_t NONE = ~size_t{0};
+
+/// reduce
+/// @brief
+/// on the fly gauss-jordan step, the new row is reduced against a reduced echelon basis
+/// (normalized pivot rows sorted by pivot column) and inserted in it when innovative,
+/// the payload operations are forwarded to data where the new row is the one after the basis
+/// @param size   number of columns that can hold a pivot
+/// @param pivots pivot column of each basis row
+/// @param c      new row (reduced in place, moved or copied into coef)
+/// @return position of the new row in the basis, or NONE when not innovative
+template <typename Pivots, typename Matrix, typename Vector, typename Data>
+static size_t reduce(size_t size, Pivots& pivots, Matrix& coef, Vector&& c, Data& data) {
+    auto row = pivots.size();
+    [[maybe_unused]] auto ops   = size_t{0};
+    [[maybe_unused]] auto bytes = size_t{0};
+    // forward elimination (remove basis pivots from the new row)
+    {
+        CODEC_SHARE_PHASE(stats::current(), FORWARD);
+        for (size_t i = 0; i < pivots.size(); ++i) {
+            auto factor = c[pivots[i]];
+            if (factor == 0) {
+                continue;
+            }
+            gf8::muladd(c, coef[i], factor, pivots[i]);
+            rows::muladd(data, row, i, factor);
+            ++ops, bytes += c.size() - pivots[i];
+        }
+    }
+    // find pivot
+    auto index = size_t{0};
+    while (index < size && c[index] == 0) {
+        ++index;
+    }
+    if (index >= size) {
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+        CODEC_SHARE_COUNT(stats::current(), BYTES, bytes + ops * rows::length(data));
+        return NONE;
+    }
+    // diagonal unification
+    {
+        CODEC_SHARE_PHASE(stats::current(), UNIFY);
+        ++ops, bytes += c.size() - index;
+        auto factor = gf8::div(1, c[index]);
+        gf8::mul(c, factor, index);
+        rows::mul(data, row, factor);
+    }
+    // backward elimination (remove the new pivot from the basis)
+    {
+        CODEC_SHARE_PHASE(stats::current(), BACKWARD);
+        for (size_t i = 0; i < pivots.size(); ++i) {
+            auto factor = coef[i][index];
+            if (factor == 0) {
+                continue;
+            }
+            gf8::muladd(coef[i], c, factor, index);
+            rows::muladd(data, i, row, factor);
+            ++ops, bytes += coef[i].size() - index;
+        }
+    }
+    CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+    CODEC_SHARE_COUNT(stats::current(), BYTES, bytes + ops * rows::length(data));
+    // insert ordered by pivot
+    auto pos = std::distance(
+      std::begin(pivots), std::lower_bound(std::begin(pivots), std::end(pivots), index));
+    pivots.insert(std::next(std::begin(pivots), pos), index);
+    coef.push_back(std::forward<Vector>(c));
+    std::rotate(std::next(std::begin(coef), pos), std::prev(std::end(coef)), std::end(coef));
+    return size_t(pos);
+}
 } // namespace share::codec::helpers
@@ -0,0 +1,270 @@
+/// ===============================================================================================
+/// @file      : sparse.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "gf8.hpp"
+#include "program.hpp"
+#include "stats.hpp"
+
+namespace share::codec::helpers {
+
+/// sparse
+/// @brief
+/// sparse elimination engine, rows are kept compressed in echelon form by insertion order
+/// (a row is zero at the pivots of the rows inserted before it), a new row is reduced with a
+/// sparse accumulator touching only its nonzeros and the rows they reach, its pivot is the
+/// nonzero column with the fewest entries in the basis (markowitz with a single row), rows
+/// filled beyond DENSE are kept dense and once the whole basis is, new rows are reduced densely
+/// against every basis row (no fill tracking), the back substitution at full rank costs one row
+/// operation per stored nonzero, payload operations are forwarded to data (see rows)
+class sparse {
+    /// rows with more than size / DENSE nonzeros are stored dense
+    static constexpr size_t DENSE = 4;
+
+  public:
+    static constexpr size_t NONE = ~size_t{0};
+
+    /// constructor
+    /// @param size number of columns
+    explicit sparse(size_t size = 0)
+      : rows_{}, pivots_{}, owner_(size, NONE), count_(size, 0), acc_(size, 0), touched_{},
+        marked_(size, false), queued_{}, heap_{}, size_{size}, nonzeros_{0} {}
+
+    /// push
+    /// @brief reduce a new row against the basis (the payload row is the one after the basis)
+    /// @param coef dense coefficients (size columns)
+    /// @param data payload operations
+    /// @return insertion index, or NONE when the row is not innovative
+    template <typename Data>
+    size_t push(const uint8_t* coef, Data& data) {
+        auto row = rows_.size();
+        // filled basis, dense forward elimination (every basis row is checked)
+        if (nonzeros_ * DENSE > rows_.size() * size_) {
+            CODEC_SHARE_PHASE(stats::current(), FORWARD);
+            [[maybe_unused]] auto ops = size_t{0};
+            std::copy(coef, coef + size_, std::begin(acc_));
+            for (size_t t = 0; t < rows_.size(); ++t) {
+                auto factor = acc_[pivots_[t]];
+                if (factor == 0)
+                    continue;
+                if (rows_[t].cols.empty())
+                    gf8::muladd(acc_.data(), rows_[t].vals.data(), size_, factor);
+                else
+                    for (size_t i = 0; i < rows_[t].cols.size(); ++i)
+                        acc_[rows_[t].cols[i]] ^= uint8_t(gf8::mul(rows_[t].vals[i], factor));
+                rows::muladd(data, row, t, factor);
+                ++ops;
+            }
+            for (size_t c = 0; c < size_; ++c) {
+                marked_[c] = true;
+                touched_.push_back(c);
+            }
+            CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+            CODEC_SHARE_COUNT(stats::current(), BYTES, ops * rows::length(data));
+        } else {
+            // load (sparse accumulator)
+            for (size_t c = 0; c < size_; ++c)
+                if (coef[c])
+                    touch(c, coef[c]);
+            // forward elimination, basis rows in insertion order
+            CODEC_SHARE_PHASE(stats::current(), FORWARD);
+            [[maybe_unused]] auto ops = size_t{0};
+            while (!heap_.empty()) {
+                auto t = heap_.top();
+                heap_.pop();
+                queued_[t] = false;
+                auto factor = acc_[pivots_[t]];
+                if (factor == 0)
+                    continue;
+                each(rows_[t], [&](size_t c, uint8_t v) {
+                    touch(c, uint8_t(gf8::mul(v, factor)));
+                });
+                rows::muladd(data, row, t, factor);
+                ++ops;
+            }
+            CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+            CODEC_SHARE_COUNT(stats::current(), BYTES, ops * rows::length(data));
+        }
+        return insert(data);
+    }
+
+    /// solve
+    /// @brief back substitution at full rank, rows in reverse insertion order
+    /// @param data payload operations
+    template <typename Data>
+    void solve(Data& data) const {
+        CODEC_SHARE_PHASE(stats::current(), BACKWARD);
+        [[maybe_unused]] auto ops = size_t{0};
+        for (auto t = rows_.size(); t-- > 0;) {
+            each(rows_[t], [&](size_t c, uint8_t v) {
+                if (c != pivots_[t] && owner_[c] != NONE) {
+                    rows::muladd(data, t, owner_[c], v);
+                    ++ops;
+                }
+            });
+        }
+        CODEC_SHARE_COUNT(stats::current(), ROWOPS, ops);
+        CODEC_SHARE_COUNT(stats::current(), BYTES, ops * rows::length(data));
+    }
+
+    /// permute
+    /// @brief move the solved rows (insertion order) to their pivot column
+    template <typename Matrix>
+    void permute(Matrix& data) const {
+        auto out = std::vector<typename Matrix::value_type>(rows_.size());
+        for (size_t t = 0; t < rows_.size(); ++t)
+            out[pivots_[t]] = std::move(data[t]);
+        for (size_t t = 0; t < rows_.size(); ++t)
+            data[t] = std::move(out[t]);
+    }
+
+    /// clear
+    void clear() {
+        rows_.clear();
+        pivots_.clear();
+        queued_.clear();
+        std::fill(std::begin(owner_), std::end(owner_), NONE);
+        std::fill(std::begin(count_), std::end(count_), 0);
+        nonzeros_ = 0;
+    }
+
+    /// quantity
+    auto rank() const { return rows_.size(); }
+    auto size() const { return size_; }
+    auto full() const { return rows_.size() >= size_; }
+    /// stored nonzeros (dense rows count their nonzeros)
+    auto nonzeros() const { return nonzeros_; }
+    /// bytes held
+    auto memory() const {
+        auto bytes = (pivots_.capacity() + owner_.capacity() + count_.capacity()
+                      + touched_.capacity()) * sizeof(size_t)
+                     + acc_.capacity() + (marked_.capacity() + queued_.capacity()) / 8;
+        for (auto& r : rows_)
+            bytes += r.cols.capacity() * sizeof(uint32_t) + r.vals.capacity();
+        return bytes;
+    }
+
+  private:
+    /// row (cols empty when dense)
+    struct entry {
+        std::vector<uint32_t> cols;
+        std::vector<uint8_t> vals;
+    };
+
+    std::vector<entry> rows_;
+    std::vector<size_t> pivots_;
+    /// row of each pivot column and basis entries of each column
+    std::vector<size_t> owner_;
+    std::vector<size_t> count_;
+    /// sparse accumulator
+    std::vector<uint8_t> acc_;
+    std::vector<size_t> touched_;
+    std::vector<bool> marked_;
+    /// basis rows to apply (min insertion index first)
+    std::vector<bool> queued_;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> heap_;
+    size_t size_;
+    size_t nonzeros_;
+
+    /// each
+    /// @brief function(column, value) over the nonzeros of a row
+    template <typename Function>
+    static void each(const entry& r, Function&& function) {
+        if (r.cols.empty()) {
+            for (size_t c = 0; c < r.vals.size(); ++c)
+                if (r.vals[c])
+                    function(c, r.vals[c]);
+            return;
+        }
+        for (size_t i = 0; i < r.cols.size(); ++i)
+            function(size_t(r.cols[i]), r.vals[i]);
+    }
+
+    /// insert
+    /// @brief pivot (nonzero column with the fewest basis entries), unification and store
+    /// @return insertion index, or NONE when the reduced row is zero
+    template <typename Data>
+    size_t insert(Data& data) {
+        auto row = rows_.size();
+        auto pivot = NONE;
+        auto nnz   = size_t{0};
+        for (auto c : touched_) {
+            if (acc_[c] == 0)
+                continue;
+            ++nnz;
+            if (pivot == NONE || count_[c] < count_[pivot]
+                || (count_[c] == count_[pivot] && c < pivot))
+                pivot = c;
+        }
+        if (pivot == NONE) {
+            reset();
+            return NONE;
+        }
+        // unification and store (compressed or dense)
+        CODEC_SHARE_PHASE(stats::current(), UNIFY);
+        auto factor = uint8_t(gf8::div(1, acc_[pivot]));
+        rows::mul(data, row, factor);
+        CODEC_SHARE_COUNT(stats::current(), BYTES, rows::length(data));
+        auto r = entry{};
+        if (nnz * DENSE > size_) {
+            r.vals.assign(size_, 0);
+            for (auto c : touched_)
+                r.vals[c] = uint8_t(gf8::mul(acc_[c], factor));
+        } else {
+            std::sort(std::begin(touched_), std::end(touched_));
+            for (auto c : touched_) {
+                if (acc_[c] == 0)
+                    continue;
+                r.cols.push_back(uint32_t(c));
+                r.vals.push_back(uint8_t(gf8::mul(acc_[c], factor)));
+            }
+        }
+        for (auto c : touched_)
+            if (acc_[c])
+                ++count_[c];
+        nonzeros_ += nnz;
+        owner_[pivot] = row;
+        pivots_.push_back(pivot);
+        rows_.push_back(std::move(r));
+        queued_.push_back(false);
+        reset();
+        return row;
+    }
+
+    /// touch
+    /// @brief acc[c] += v, queue the basis row of a pivot column
+    void touch(size_t c, uint8_t v) {
+        if (!marked_[c]) {
+            marked_[c] = true;
+            touched_.push_back(c);
+        }
+        acc_[c] ^= v;
+        auto t = owner_[c];
+        if (t != NONE && acc_[c] && !queued_[t]) {
+            queued_[t] = true;
+            heap_.push(t);
+        }
+    }
+
+    /// reset
+    void reset() {
+        for (auto c : touched_) {
+            acc_[c]    = 0;
+            marked_[c] = false;
+        }
+        touched_.clear();
+    }
+};
+} // namespace share::codec::helpers
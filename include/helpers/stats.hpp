@@ -0,0 +1,259 @@
+/// ===============================================================================================
+/// @file      : stats.hpp                                                 |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace share::codec::helpers {
+
+/// trace
+/// @brief
+/// thread safe recorder of timed events, exported in the chrome trace event format
+/// (chrome://tracing, perfetto)
+class trace {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// event
+    struct event {
+        const char* name;
+        Clock::time_point begin;
+        Clock::time_point end;
+        size_t thread;
+    };
+
+    /// constructor
+    trace() : mutex_{}, events_{}, origin_{Clock::now()} {}
+
+    /// record
+    /// @param name  static string
+    /// @param begin
+    /// @param end
+    void record(const char* name, Clock::time_point begin, Clock::time_point end) {
+        auto thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back({name, begin, end, thread});
+    }
+
+    /// json
+    /// @return {"traceEvents": [...]} with complete events (microseconds)
+    std::string json() const {
+        auto us  = [this](Clock::time_point t) {
+            return std::chrono::duration<double, std::micro>(t - origin_).count();
+        };
+        auto out = std::ostringstream();
+        out << "{\"traceEvents\":[";
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < events_.size(); ++i) {
+            auto& e = events_[i];
+            out << (i ? "," : "") << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"ts\":"
+                << us(e.begin) << ",\"dur\":" << (us(e.end) - us(e.begin))
+                << ",\"pid\":1,\"tid\":" << (e.thread & 0xFFFFFF) << "}";
+        }
+        out << "]}";
+        return out.str();
+    }
+
+    /// quantity
+    auto size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_.size();
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.clear();
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<event> events_;
+    Clock::time_point origin_;
+};
+
+/// stats
+/// @brief
+/// counters and phase timings of an encoder, a decoder or a solve, updated through the
+/// CODEC_SHARE_COUNT / CODEC_SHARE_PHASE macros that compile to nothing unless
+/// CODEC_SHARE_STATS is defined (relaxed atomics, so reentrant encoders can share them)
+class stats {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// counters
+    enum Counter {
+        FRAMES,      // frames received (decoder) or produced (encoder)
+        INNOVATIVE,  // frames that increased the rank
+        REDUNDANT,   // frames that did not increase the rank
+        RANK,        // current rank
+        ROWOPS,      // row operations (multiply, multiply and add)
+        BYTES,       // bytes multiplied / added
+        RETRIES,     // seeds rejected by the encoder
+        ALLOCATIONS, // frames allocated by the pool during the calls
+        COUNTERS
+    };
+
+    /// phases
+    enum Phase {
+        COEFFICIENTS, // coefficient generation
+        FORWARD,      // forward elimination
+        BACKWARD,     // backward substitution
+        UNIFY,        // diagonal unification
+        PAYLOAD,      // payload combination
+        PHASES
+    };
+
+    /// constructor
+    stats() : counters_{}, times_{}, trace_{} {}
+
+    /// copy (snapshot of the values)
+    stats(const stats& other) : stats() { *this = other; }
+    stats& operator=(const stats& other) {
+        for (size_t i = 0; i < COUNTERS; ++i)
+            counters_[i].store(other.counters_[i].load(std::memory_order_relaxed));
+        for (size_t i = 0; i < PHASES; ++i)
+            times_[i].store(other.times_[i].load(std::memory_order_relaxed));
+        trace_ = other.trace_;
+        return *this;
+    }
+
+    /// update
+    void add(Counter c, uint64_t n) { counters_[c].fetch_add(n, std::memory_order_relaxed); }
+    void set(Counter c, uint64_t n) { counters_[c].store(n, std::memory_order_relaxed); }
+    void time(Phase p, Clock::time_point begin, Clock::time_point end) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        times_[p].fetch_add(uint64_t(ns), std::memory_order_relaxed);
+        if (trace_)
+            trace_->record(name(p), begin, end);
+    }
+
+    /// read
+    uint64_t get(Counter c) const { return counters_[c].load(std::memory_order_relaxed); }
+    /// @return accumulated nanoseconds of a phase
+    uint64_t time(Phase p) const { return times_[p].load(std::memory_order_relaxed); }
+
+    /// reset
+    void reset() {
+        for (auto& c : counters_)
+            c.store(0, std::memory_order_relaxed);
+        for (auto& t : times_)
+            t.store(0, std::memory_order_relaxed);
+    }
+
+    /// trace
+    /// @brief phases are also recorded as trace events (may be shared)
+    /// @param trace
+    void trace(std::shared_ptr<helpers::trace> trace) { trace_ = std::move(trace); }
+    auto& trace() const { return trace_; }
+
+    /// json
+    /// @return {"counters": {...}, "phases": {... nanoseconds}}
+    std::string json() const {
+        static const char* COUNTER_NAMES[] = {
+          "frames", "innovative", "redundant", "rank", "rowops", "bytes", "retries", "allocations"};
+        auto out = std::ostringstream();
+        out << "{\"counters\":{";
+        for (size_t i = 0; i < COUNTERS; ++i)
+            out << (i ? "," : "") << "\"" << COUNTER_NAMES[i] << "\":" << get(Counter(i));
+        out << "},\"phases\":{";
+        for (size_t i = 0; i < PHASES; ++i)
+            out << (i ? "," : "") << "\"" << name(Phase(i)) << "\":" << time(Phase(i));
+        out << "}}";
+        return out.str();
+    }
+
+    /// name
+    static const char* name(Phase p) {
+        static const char* NAMES[] = {"coefficients", "forward", "backward", "unify", "payload"};
+        return NAMES[p];
+    }
+
+    /// current
+    /// @brief stats of the calling thread used by the free functions (solve, reduce)
+    static stats*& current() {
+        thread_local stats* current = nullptr;
+        return current;
+    }
+
+    /// bind
+    /// @brief scoped current stats of the calling thread
+    class bind {
+      public:
+        explicit bind(stats* s) : previous_{current()} { current() = s; }
+        ~bind() { current() = previous_; }
+        bind(const bind&) = delete;
+        bind& operator=(const bind&) = delete;
+
+      private:
+        stats* previous_;
+    };
+
+    /// timer
+    /// @brief scoped phase timing (no-op without stats)
+    class timer {
+      public:
+        timer(stats* s, Phase p)
+          : stats_{s}, phase_{p}, begin_{s ? Clock::now() : Clock::time_point{}} {}
+        ~timer() {
+            if (stats_)
+                stats_->time(phase_, begin_, Clock::now());
+        }
+        timer(const timer&) = delete;
+        timer& operator=(const timer&) = delete;
+
+      private:
+        stats* stats_;
+        Phase phase_;
+        Clock::time_point begin_;
+    };
+
+  private:
+    std::array<std::atomic<uint64_t>, COUNTERS> counters_;
+    std::array<std::atomic<uint64_t>, PHASES> times_;
+    std::shared_ptr<helpers::trace> trace_;
+};
+} // namespace share::codec::helpers
+
+/// instrumentation (compiled out unless CODEC_SHARE_STATS is defined)
+///   CODEC_SHARE_COUNT(ptr, COUNTER, n) : add n to a counter of a stats pointer (may be null)
+///   CODEC_SHARE_SET(ptr, COUNTER, n)   : set a counter
+///   CODEC_SHARE_PHASE(ptr, PHASE)      : time the rest of the scope as a phase
+///   CODEC_SHARE_BIND(ptr)              : current stats of the thread for the rest of the scope
+#define CODEC_SHARE_CONCAT_(a, b) a##b
+#define CODEC_SHARE_CONCAT(a, b)  CODEC_SHARE_CONCAT_(a, b)
+#ifdef CODEC_SHARE_STATS
+#define CODEC_SHARE_COUNT(ptr, COUNTER, n)                                                        \
+    do {                                                                                          \
+        if (auto* codec_share_stats_ = (ptr))                                                     \
+            codec_share_stats_->add(share::codec::helpers::stats::COUNTER, uint64_t(n));         \
+    } while (0)
+#define CODEC_SHARE_SET(ptr, COUNTER, n)                                                          \
+    do {                                                                                          \
+        if (auto* codec_share_stats_ = (ptr))                                                     \
+            codec_share_stats_->set(share::codec::helpers::stats::COUNTER, uint64_t(n));         \
+    } while (0)
+#define CODEC_SHARE_PHASE(ptr, PHASE)                                                             \
+    share::codec::helpers::stats::timer CODEC_SHARE_CONCAT(codec_share_timer_, __LINE__)(       \
+      (ptr), share::codec::helpers::stats::PHASE)
+#define CODEC_SHARE_BIND(ptr)                                                                     \
+    share::codec::helpers::stats::bind CODEC_SHARE_CONCAT(codec_share_bind_, __LINE__)(ptr)
+#else
+#define CODEC_SHARE_COUNT(ptr, COUNTER, n) ((void)0)
+#define CODEC_SHARE_SET(ptr, COUNTER, n)   ((void)0)
+#define CODEC_SHARE_PHASE(ptr, PHASE)      ((void)0)
+#define CODEC_SHARE_BIND(ptr)              ((void)0)
+#endif
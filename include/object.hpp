@@ -0,0 +1,308 @@
+/// ===============================================================================================
+/// @file      : object.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "header.hpp"
+#include "seed.hpp"
+#include "span.hpp"
+#include "helpers/parallel.hpp"
+
+namespace share::codec::object {
+
+/// ===============================================================================================
+/// layout
+/// @brief
+///   split of an object of length bytes into generations of k frames of framesize bytes,
+///   only the last generation may be shorter (fewer frames, zero padded last frame)
+/// ===============================================================================================
+struct layout {
+    size_t length;
+    size_t k;
+    size_t framesize;
+
+    /// bytes per (full) generation
+    size_t stride() const { return k * framesize; }
+    /// number of generations
+    size_t generations() const { return (length + stride() - 1) / stride(); }
+    /// first byte of generation g
+    size_t offset(size_t g) const { return g * stride(); }
+    /// bytes of generation g
+    size_t bytes(size_t g) const { return std::min(stride(), length - offset(g)); }
+    /// frames of generation g
+    size_t frames(size_t g) const { return (bytes(g) + framesize - 1) / framesize; }
+};
+
+/// checked
+/// @brief layout of an object of length bytes, k is limited by the header size field
+/// @param length
+/// @param in
+/// @throw Exception when k or framesize is zero
+template <typename Exception>
+static layout checked(size_t length, const layout& in) {
+    if (in.k == 0 || in.framesize == 0)
+        throw Exception("empty generation layout");
+    return {length, std::min(in.k, header::CAPACITY), in.framesize};
+}
+
+/// ===============================================================================================
+/// encoder
+/// @brief
+///   object coder, generations are views of the object (no copy but the padded last frame)
+///   built on demand, so memory does not grow with the object, frames carry a header with
+///   the generation index as id (see header), batches of generations are coded in parallel
+/// ===============================================================================================
+template <typename Vector, typename Random = std::random_device, typename Generator = std::minstd_rand0>
+class encoder {
+  public:
+    using Encoder   = codec::encoder<Vector, Random, Generator>;
+    using Container = typename Encoder::Container;
+    using Parallel  = std::shared_ptr<helpers::parallel>;
+    using Layout    = object::layout;
+
+    /// constructor
+    /// @param data   object, the viewed memory must outlive the encoder
+    /// @param layout (length is taken from data)
+    /// @param token
+    /// @param parallel generations are coded on the workers
+    /// @throw Container::exception when k or framesize is zero
+    encoder(
+      span data,
+      Layout layout,
+      token::shared::Stamp token = token::get(token::Type::FULL),
+      Parallel parallel          = {})
+      : data_{data},
+        layout_{checked<typename Container::exception>(data.size(), layout)},
+        token_{token},
+        parallel_{std::move(parallel)} {}
+
+    /// pop
+    /// @brief reentrant
+    /// @param generation index
+    /// @param size       coded frames
+    /// @return coded frames with header
+    Container pop(size_t generation, size_t size) const {
+        if (generation >= layout_.generations())
+            return {};
+        auto coder = Encoder(layout_.frames(generation), token_);
+        coder.push(data_.subspan(layout_.offset(generation), layout_.bytes(generation)),
+                   layout_.framesize);
+        return coder.pop(size, uint32_t(generation));
+    }
+
+    /// pop
+    /// @brief generations [first, first + count) in parallel
+    /// @param first      generation
+    /// @param count      generations
+    /// @param redundancy coded frames beyond the generation size
+    /// @return coded frames with header, one container per generation
+    std::vector<Container> pop(size_t first, size_t count, size_t redundancy) const {
+        first = std::min(first, layout_.generations());
+        count = std::min(count, layout_.generations() - first);
+        auto out = std::vector<Container>(count);
+        auto job = [&](size_t n) {
+            out[n] = pop(first + n, layout_.frames(first + n) + redundancy);
+        };
+        if (parallel_)
+            parallel_->each(count, job);
+        else
+            for (size_t n = 0; n < count; ++n)
+                job(n);
+        return out;
+    }
+
+    /// layout
+    auto& layout() const { return layout_; }
+    auto generations() const { return layout_.generations(); }
+
+  private:
+    span data_;
+    Layout layout_;
+    token::shared::Stamp token_;
+    Parallel parallel_;
+};
+
+/// ===============================================================================================
+/// decoder
+/// @brief
+///   object decoder, frames are routed to the decoder of their generation (created on the
+///   first frame, released once decoded), decoded frames are written once at their offset of
+///   the single output buffer (or handed to a sink), generations of a batch are decoded in
+///   parallel
+/// ===============================================================================================
+template <typename Vector, typename Generator = std::minstd_rand0>
+class decoder {
+  public:
+    using Decoder   = codec::decoder<Vector, Generator>;
+    using Container = typename Decoder::Container;
+    using Parallel  = std::shared_ptr<helpers::parallel>;
+    using Layout    = object::layout;
+
+    /// decoded bytes consumer (offset, data, size), called from the workers concurrently
+    using Sink = std::function<void(size_t, const uint8_t*, size_t)>;
+
+    /// constructor
+    /// @param layout   of the encoder
+    /// @param token
+    /// @param parallel generations are decoded on the workers
+    /// @throw Container::exception when k or framesize is zero
+    decoder(
+      Layout layout,
+      token::shared::Stamp token = token::get(token::Type::FULL),
+      Parallel parallel          = {})
+      : data_(layout.length),
+        layout_{checked<typename Container::exception>(layout.length, layout)},
+        done_(layout_.generations(), false),
+        count_{0},
+        active_{},
+        token_{token},
+        parallel_{std::move(parallel)},
+        sink_{} {}
+
+    /// constructor
+    /// @brief streaming, decoded generations are handed to the sink (no output buffer)
+    /// @param layout   of the encoder
+    /// @param sink
+    /// @param token
+    /// @param parallel generations are decoded on the workers
+    /// @throw Container::exception when k or framesize is zero
+    decoder(
+      Layout layout,
+      Sink sink,
+      token::shared::Stamp token = token::get(token::Type::FULL),
+      Parallel parallel          = {})
+      : data_{},
+        layout_{checked<typename Container::exception>(layout.length, layout)},
+        done_(layout_.generations(), false),
+        count_{0},
+        active_{},
+        token_{token},
+        parallel_{std::move(parallel)},
+        sink_{std::move(sink)} {}
+
+    /// push
+    /// @param frames coded with header (any generation, any order)
+    /// @return number of generations decoded
+    size_t push(Container frames) {
+        // route (generations of the batch)
+        auto batch = std::vector<Batch>();
+        auto index = std::unordered_map<uint32_t, size_t>();
+        auto head  = header{};
+        for (auto& frame : frames) {
+            if (!header::parse(frame, head) || !accept(head))
+                continue;
+            auto it = index.find(head.id);
+            if (it == index.end()) {
+                auto& coder = active_.try_emplace(head.id, head.size, token_).first->second;
+                it          = index.emplace(head.id, batch.size()).first;
+                batch.push_back({head.id, &coder, Container{}, false});
+            }
+            header::detach(frame);
+            batch[it->second].input.push_back(std::move(frame));
+        }
+        // decode (one generation per task, decoders and output ranges are disjoint)
+        auto job = [&](size_t n) {
+            auto& b = batch[n];
+            b.coder->push(std::move(b.input));
+            if ((b.full = b.coder->full()))
+                write(b.id, *b.coder);
+        };
+        if (parallel_)
+            parallel_->each(batch.size(), job);
+        else
+            for (size_t n = 0; n < batch.size(); ++n)
+                job(n);
+        // release
+        for (auto& b : batch) {
+            if (!b.full)
+                continue;
+            active_.erase(b.id);
+            done_[b.id] = true;
+            ++count_;
+        }
+        return count_;
+    }
+
+    /// push
+    /// @param frame coded with header
+    /// @return number of generations decoded
+    size_t push(Vector frame) {
+        auto frames = Container();
+        frames.push_back(std::move(frame));
+        return push(std::move(frames));
+    }
+
+    /// data
+    /// @return object (complete when full, empty with a sink)
+    auto& data() const { return data_; }
+
+    /// pop
+    /// @return object (the decoder is left empty)
+    Vector pop() { return std::move(data_); }
+
+    /// quantity
+    auto full() const { return count_ == layout_.generations(); }
+    auto decoded() const { return count_; }
+    auto pending() const { return active_.size(); }
+    bool decoded(size_t generation) const { return done_.at(generation); }
+    auto& layout() const { return layout_; }
+
+  private:
+    /// frames of a generation in a push
+    struct Batch {
+        uint32_t id;
+        Decoder* coder;
+        Container input;
+        bool full;
+    };
+
+    /// output
+    Vector data_;
+    /// context
+    Layout layout_;
+    std::vector<bool> done_;
+    size_t count_;
+    std::unordered_map<uint32_t, Decoder> active_;
+    /// property
+    token::shared::Stamp token_;
+    Parallel parallel_;
+    Sink sink_;
+
+    /// accept
+    /// @brief the frame belongs to a generation of the layout not yet decoded
+    ///        (recoded frames carry one coefficient per frame of the generation)
+    bool accept(const header& head) const {
+        auto coefficients = seed::recoded(head.seed) ? size_t{head.size} : size_t{0};
+        return head.id < done_.size() && !done_[head.id] && head.size == layout_.frames(head.id)
+               && head.length == layout_.framesize + coefficients;
+    }
+
+    /// write
+    /// @brief copy the decoded frames of a generation to the output (padding dropped)
+    void write(uint32_t id, Decoder& coder) {
+        auto offset = layout_.offset(id);
+        auto left   = layout_.bytes(id);
+        for (auto& frame : coder.pop()) {
+            auto n = std::min(left, frame.size());
+            if (sink_)
+                sink_(offset, frame.data(), n);
+            else
+                std::copy_n(std::begin(frame), n, std::next(std::begin(data_), offset));
+            offset += n;
+            left -= n;
+        }
+    }
+};
+} // namespace share::codec::object
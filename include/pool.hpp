@@ -0,0 +1,188 @@
+/// ===============================================================================================
+/// @file      : pool.hpp                                                  |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "container.hpp"
+#include "helpers/stats.hpp"
+
+namespace share::codec {
+
+/// ===============================================================================================
+/// huge allocator
+/// @brief
+///   large buffers are aligned to (and advised as) transparent huge pages,
+///   small buffers use the default allocator, Vector = std::vector<uint8_t, huge_allocator<uint8_t>>
+/// ===============================================================================================
+template <typename T>
+class huge_allocator {
+  public:
+    using value_type = T;
+
+    static constexpr size_t HUGE_PAGE = size_t{1} << 21;
+
+    /// constructors
+    huge_allocator() = default;
+    template <typename U>
+    huge_allocator(const huge_allocator<U>&) {}
+
+    /// allocate
+    /// @param n
+    T* allocate(size_t n) {
+        auto bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE)
+            return std::allocator<T>{}.allocate(n);
+        bytes    = (bytes + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+        auto ptr = std::aligned_alloc(HUGE_PAGE, bytes);
+        if (!ptr)
+            throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+        return static_cast<T*>(ptr);
+    }
+
+    /// deallocate
+    /// @param ptr
+    /// @param n
+    void deallocate(T* ptr, size_t n) {
+        if (n * sizeof(T) < HUGE_PAGE)
+            return std::allocator<T>{}.deallocate(ptr, n);
+        std::free(ptr);
+    }
+
+    /// comparison
+    template <typename U>
+    bool operator==(const huge_allocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const huge_allocator<U>&) const { return false; }
+};
+
+/// ===============================================================================================
+/// pool
+/// @brief
+///   thread safe free list of frames (and frame containers), frames keep their capacity
+///   so a warm pool serves encoder and decoder hot paths without heap allocations
+/// ===============================================================================================
+template <typename Vector>
+class pool {
+    static constexpr size_t DEFAULT_LIMIT = 1024;
+
+  public:
+    using Container = codec::container<Vector>;
+
+    /// constructor
+    /// @param limit maximum number of retained frames
+    explicit pool(size_t limit = DEFAULT_LIMIT)
+      : mutex_{}, frames_{}, containers_{}, limit_{limit}, bytes_{0} {}
+
+    /// frame
+    /// @param size    zero filled bytes
+    /// @param reserve minimum capacity
+    /// @return recycled (or new) frame
+    Vector frame(size_t size, size_t reserve = 0) {
+        auto out = Vector();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!frames_.empty()) {
+                out = std::move(frames_.back());
+                frames_.pop_back();
+                bytes_ -= bytes(out);
+            }
+        }
+        if (out.capacity() < std::max(size, reserve))
+            CODEC_SHARE_COUNT(helpers::stats::current(), ALLOCATIONS, 1);
+        out.reserve(std::max(size, reserve));
+        out.assign(size, 0);
+        return out;
+    }
+
+    /// container
+    /// @return recycled (or new) empty container
+    Container container() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (containers_.empty())
+            return Container();
+        auto out = std::move(containers_.back());
+        containers_.pop_back();
+        return out;
+    }
+
+    /// recycle
+    /// @param frame consumed
+    void recycle(Vector frame) {
+        if (frame.capacity() == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (frames_.size() < limit_) {
+            bytes_ += bytes(frame);
+            frames_.push_back(std::move(frame));
+        }
+    }
+
+    /// recycle
+    /// @param frames consumed (container included)
+    void recycle(Container frames) {
+        for (auto& frame : frames)
+            recycle(std::move(frame));
+        frames.clear();
+        if (frames.capacity() == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (containers_.size() < limit_)
+            containers_.push_back(std::move(frames));
+    }
+
+    /// quantity
+    auto size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_.size();
+    }
+    auto limit() const { return limit_; }
+    /// bytes held by the free frames
+    auto memory() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes_;
+    }
+
+    /// shrink
+    /// @brief free frames (most recent first) until at most bytes are held
+    /// @param bytes
+    void shrink(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (bytes_ > bytes && !frames_.empty()) {
+            bytes_ -= pool::bytes(frames_.back());
+            frames_.pop_back();
+        }
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<Vector> frames_;
+    std::vector<Container> containers_;
+    size_t limit_;
+    size_t bytes_;
+
+    /// bytes
+    /// @return capacity of a frame in bytes
+    static size_t bytes(const Vector& frame) {
+        return frame.capacity() * sizeof(typename Vector::value_type);
+    }
+};
+} // namespace share::codec
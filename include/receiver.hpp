@@ -0,0 +1,154 @@
+/// ===============================================================================================
+/// @file      : receiver.hpp                                              |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "stream.hpp"
+#include "helpers/queue.hpp"
+
+namespace share::codec {
+
+/// ===============================================================================================
+/// receiver
+/// @brief
+///   asynchronous ostream, receive threads enqueue coded frames in a lock-free ring (no
+///   allocation, no lock, the cost does not depend on the frame size or the generation size)
+///   and a dedicated worker drains it in batches into the ostream, each decoded message is
+///   handed to the callback on the worker thread
+/// ===============================================================================================
+template <typename Vector = std::vector<uint8_t>, typename Size = uint32_t>
+class receiver {
+    static constexpr int DEFAULT_CAPACITY = 100;
+    /// idle worker polling period (a missed wake up costs at most this)
+    static constexpr auto IDLE = std::chrono::milliseconds(1);
+    /// polls before the worker sleeps
+    static constexpr size_t SPIN = 64;
+
+  public:
+    /// decoded message consumer
+    using Callback = std::function<void(Vector)>;
+
+    /// constructor
+    /// @param callback decoded messages (worker thread)
+    /// @param capacity generation size of the ostream
+    /// @param token
+    /// @param queue    ring size in frames (rounded up to a power of two)
+    explicit receiver(
+      Callback callback,
+      size_t capacity            = DEFAULT_CAPACITY,
+      token::shared::Stamp token = token::get(token::Type::FULL),
+      size_t queue               = helpers::queue<Vector>::DEFAULT_CAPACITY)
+      : stream_(capacity, token),
+        queue_{queue},
+        callback_{std::move(callback)},
+        mutex_{},
+        wake_{},
+        sleeping_{false},
+        stop_{false},
+        dropped_{0},
+        decoded_{0},
+        worker_{} {
+        worker_ = std::thread([this]() { work(); });
+    }
+
+    /// destructor
+    /// @brief the frames still queued are decoded before the worker stops
+    ~receiver() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_.store(true, std::memory_order_release);
+        }
+        wake_.notify_one();
+        worker_.join();
+    }
+
+    receiver(const receiver&) = delete;
+    receiver& operator=(const receiver&) = delete;
+
+    /// push
+    /// @brief any thread, lock-free
+    /// @param frame coded (moved in on success)
+    /// @return false when the ring is full (the frame is dropped)
+    bool push(Vector&& frame) {
+        if (!queue_.push(frame)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (sleeping_.load(std::memory_order_acquire))
+            wake_.notify_one();
+        return true;
+    }
+
+    /// quantity
+    auto pending() const { return queue_.size(); }
+    auto dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    auto decoded() const { return decoded_.load(std::memory_order_relaxed); }
+
+  private:
+    /// decoding (worker only)
+    ostream<Vector, Size> stream_;
+    helpers::queue<Vector> queue_;
+    Callback callback_;
+    /// idle worker
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> sleeping_;
+    std::atomic<bool> stop_;
+    /// counters
+    std::atomic<size_t> dropped_;
+    std::atomic<size_t> decoded_;
+    std::thread worker_;
+
+    /// drain
+    /// @return number of frames decoded
+    size_t drain() {
+        auto frame = Vector();
+        auto count = size_t{0};
+        while (queue_.pop(frame)) {
+            ++count;
+            if (stream_.push(std::move(frame)) == 0)
+                continue;
+            decoded_.fetch_add(1, std::memory_order_relaxed);
+            if (callback_)
+                callback_(stream_.get());
+        }
+        return count;
+    }
+
+    /// work
+    void work() {
+        for (auto idle = size_t{0};;) {
+            if (drain()) {
+                idle = 0;
+                continue;
+            }
+            if (stop_.load(std::memory_order_acquire)) {
+                drain();
+                return;
+            }
+            if (++idle < SPIN) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.store(true, std::memory_order_release);
+            wake_.wait_for(lock, IDLE, [this]() {
+                return stop_.load(std::memory_order_acquire) || !queue_.empty();
+            });
+            sleeping_.store(false, std::memory_order_release);
+            idle = 0;
+        }
+    }
+};
+} // namespace share::codec
@@ -0,0 +1,244 @@
+/// ===============================================================================================
+/// @file      : recoder.hpp                                               |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <random>
+
+#include "container.hpp"
+#include "header.hpp"
+#include "pool.hpp"
+#include "seed.hpp"
+#include "token.hpp"
+#include "helpers/combine.hpp"
+#include "helpers/copy.hpp"
+#include "helpers/matrix.hpp"
+#include "helpers/program.hpp"
+#include "helpers/solve.hpp"
+
+namespace share::codec {
+
+/// ===============================================================================================
+/// recoder
+/// @brief
+///   relay node, coded frames are buffered (innovative ones only, any rank) together with their
+///   coefficients and new random combinations of them are produced without decoding, recoded
+///   frames carry their coefficients explicitly before a RECODED seed (see seed):
+///   [payload][coefficients:capacity][seed:4] (understood by the decoder)
+///   the Generator must match the one of the encoder, the Random seeds the combination factors
+/// ===============================================================================================
+template <typename Vector, typename Random = std::random_device, typename Generator = std::minstd_rand0>
+class recoder {
+  public:
+    // helpers
+    using Container = container<Vector>;
+    using Pool      = std::shared_ptr<codec::pool<Vector>>;
+
+    /// encode header size
+    const size_t HEADER_SIZE = sizeof(uint32_t);
+
+    /// constructor
+    /// @param capacity generation size
+    /// @param token    of the encoder
+    recoder(size_t capacity, token::shared::Stamp token = token::get(token::Type::FULL))
+      : data_{},
+        coef_{0, capacity, capacity},
+        pivots_{},
+        row_{},
+        factors_{},
+        capacity_{capacity},
+        mask_{0},
+        token_{token},
+        pool_{std::make_shared<codec::pool<Vector>>()} {
+        // combination factors are limited to the token fields (binary stays binary, a
+        // token without fields is binary as in the decoder)
+        for (auto& density : *token_)
+            mask_ |= density.first;
+        mask_ = std::max(mask_, uint8_t{1});
+        data_.reserve(capacity_);
+        pivots_.reserve(capacity_);
+    }
+
+    /// move constructor
+    recoder(recoder&&) = default;
+
+    /// move operator
+    recoder& operator=(recoder&&) = default;
+
+    /// push
+    /// @brief coded or recoded frames, those that do not increase the rank are dropped
+    /// @param data
+    /// @return number of innovative frames
+    size_t push(Container data);
+
+    /// push
+    /// @param data
+    /// @return true when the frame is innovative
+    bool push(Vector data) {
+        auto frames = pool_->container();
+        frames.push_back(std::move(data));
+        return push(std::move(frames)) != 0;
+    }
+
+    /// pop
+    /// @brief random combinations of the buffered frames (recoded frames)
+    /// @param size
+    Container pop(size_t size) { return recode(size, 0); }
+
+    /// pop
+    /// @brief recoded frames with a header (see demux)
+    /// @param size
+    /// @param id   generation id
+    Container pop(size_t size, uint32_t id) {
+        if (capacity_ > header::CAPACITY)
+            throw typename Container::exception("generation size exceeds the header");
+        auto code = recode(size, header::EXTRA);
+        for (auto& frame : code)
+            header::attach(frame, id, uint16_t(capacity_));
+        return code;
+    }
+
+    /// clear
+    void clear() {
+        for (auto& frame : data_)
+            pool_->recycle(std::move(frame));
+        data_.clear();
+        coef_.clear();
+        pivots_.clear();
+    }
+
+    /// pool
+    /// @brief frames are recycled through the pool (may be shared with encoders / decoders)
+    /// @param pool
+    void pool(Pool pool) { pool_ = std::move(pool); }
+    auto& pool() const { return pool_; }
+
+    /// recycle
+    /// @brief hand consumed recoded frames back to the pool
+    /// @param frames
+    void recycle(Container frames) { pool_->recycle(std::move(frames)); }
+
+    /// quantity
+    auto rank() const { return data_.size(); }
+    auto full() const { return data_.size() >= capacity_; }
+    auto empty() const { return data_.empty(); }
+    auto capacity() const { return capacity_; }
+
+  private:
+    /// buffered frames [payload][coefficients] (innovative, received order)
+    Container data_;
+    /// Cache (coefficient only reduced echelon basis, innovation test)
+    helpers::matrix coef_;
+    std::vector<size_t> pivots_;
+    /// Cache (coefficients of the frame being pushed)
+    Vector row_;
+    /// Cache (combination factors of a pop)
+    helpers::matrix factors_;
+    /// Context
+    size_t capacity_;
+    uint8_t mask_;
+    /// Property
+    token::shared::Stamp token_;
+    Pool pool_;
+
+    /// recode
+    /// @param size
+    /// @param extra bytes reserved past the seed (header)
+    Container recode(size_t size, size_t extra);
+
+    /// seeds
+    /// @brief per thread factor stream, seeded once from Random
+    static auto& seeds() {
+        thread_local auto stream = std::mt19937{Random{}()};
+        return stream;
+    }
+};
+
+/// push
+/// @param data
+template <typename Vector, typename Random, typename Generator>
+size_t recoder<Vector, Random, Generator>::push(Container data) {
+    auto innovative = size_t{0};
+    for (auto& frame : data) {
+        if (full() || frame.size() < HEADER_SIZE)
+            continue;
+        // remove seed
+        auto seed = uint32_t{0};
+        helpers::copy(std::prev(std::end(frame), HEADER_SIZE), seed);
+        frame.resize(frame.size() - HEADER_SIZE);
+        // coefficients (explicit, identity row or generated)
+        row_.assign(capacity_, 0);
+        if (seed::recoded(seed)) {
+            if (frame.size() < capacity_)
+                continue;
+            std::copy(std::prev(std::end(frame), capacity_), std::end(frame), std::begin(row_));
+            frame.resize(frame.size() - capacity_);
+        } else if (seed::reserved(seed)) {
+            if (seed::index(seed) >= capacity_)
+                continue;
+            row_[seed::index(seed)] = 1;
+        } else {
+            auto field    = uint8_t{(*token_)[uint8_t(seed)].first};
+            auto sparsity = uint8_t{(*token_)[uint8_t(seed)].second};
+            helpers::coefficients<Generator>(seed, field, sparsity, row_);
+        }
+        // payload and coefficients are combined as one row
+        frame.insert(std::end(frame), std::begin(row_), std::end(row_));
+        if (!data_.empty() && frame.size() != data_.front().size())
+            continue;
+        // innovation test (coefficients only)
+        auto none = helpers::none{};
+        if (helpers::reduce(capacity_, pivots_, coef_, row_, none) == helpers::NONE)
+            continue;
+        data_.push_back(std::move(frame));
+        ++innovative;
+    }
+    // dropped frames back to the pool
+    pool_->recycle(std::move(data));
+    return innovative;
+}
+
+/// recode
+/// @param size
+/// @param extra
+/// @return recoded frames
+template <typename Vector, typename Random, typename Generator>
+auto recoder<Vector, Random, Generator>::recode(size_t size, size_t extra) -> Container {
+    auto code = pool_->container();
+    if (data_.empty())
+        return code;
+    // combination factors (at least one non zero per frame)
+    auto& stream = seeds();
+    factors_.reshape(size, data_.size());
+    for (size_t i = 0; i < size; ++i) {
+        auto row = factors_[i];
+        do {
+            std::generate(std::begin(row), std::end(row), [&] {
+                return uint8_t(stream() & mask_);
+            });
+        } while (std::all_of(std::begin(row), std::end(row), [](auto f) { return f == 0; }));
+    }
+    // combinations of [payload][coefficients] rows
+    auto length = data_.front().size();
+    for (size_t i = 0; i < size; ++i)
+        code.push_back(pool_->frame(length, length + HEADER_SIZE + extra));
+    helpers::combine(data_, factors_, code);
+    // insert seeds
+    for (auto& frame : code) {
+        auto value = seed::RECODED;
+        frame.push_back(uint8_t(value));
+        value >>= 8;
+        frame.push_back(uint8_t(value));
+        value >>= 8;
+        frame.push_back(uint8_t(value));
+        value >>= 8;
+        frame.push_back(uint8_t(value));
+    }
+    return code;
+}
+} // namespace share::codec
@@ -0,0 +1,49 @@
+/// ===============================================================================================
+/// @file      : seed.hpp                                                  |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Codec Seed
+namespace share::codec {
+namespace seed {
+    /// Systematic seeds
+    ///   the upper half of the seed is a reserved marker and
+    ///   the lower half the index of the source frame carried unchanged
+    static constexpr uint32_t SYSTEMATIC = 0xFFFF0000;
+    static constexpr uint32_t INDEX      = 0x0000FFFF;
+
+    /// reserved seed (systematic, never used for combinations)
+    /// @param seed
+    inline constexpr bool reserved(uint32_t seed) { return (seed & SYSTEMATIC) == SYSTEMATIC; }
+
+    /// systematic seed of a source frame
+    /// @param index
+    /// @throw std::out_of_range when the index is past 0xFFFE (0xFFFF is the recoded seed)
+    inline constexpr uint32_t systematic(size_t index) {
+        if (index >= INDEX)
+            throw std::out_of_range("systematic index exceeds the seed");
+        return SYSTEMATIC | uint32_t(index);
+    }
+
+    /// source frame index of a systematic seed
+    /// @param seed
+    inline constexpr size_t index(uint32_t seed) { return size_t(seed & INDEX); }
+
+    /// Recoded seed
+    ///   the combination coefficients are carried explicitly before the seed (see recoder),
+    ///   it takes the systematic index 0xFFFF (generations hold at most 0xFFFF frames)
+    static constexpr uint32_t RECODED = 0xFFFFFFFF;
+
+    /// recoded seed (explicit coefficients)
+    /// @param seed
+    inline constexpr bool recoded(uint32_t seed) { return seed == RECODED; }
+} // namespace seed
+} // namespace share::codec
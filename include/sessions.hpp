@@ -0,0 +1,288 @@
+/// ===============================================================================================
+/// @file      : sessions.hpp                                              |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "decoder.hpp"
+#include "pool.hpp"
+
+namespace share::codec {
+
+/// ===============================================================================================
+/// sessions
+/// @brief
+///   decoders of many concurrent sessions (stream / generation id) under a memory budget,
+///   a decoder is created on the first frame of a session (from a released one of the same
+///   capacity when available, its coefficient slab and caches are kept) and all of them share
+///   one frame pool, sessions are kept in least recently used order (hash map and list, O(1))
+///   and evicted when idle beyond the timeout or, least recent first, when the memory held
+///   exceeds the budget (free pool frames, then released decoders, are dropped first)
+/// ===============================================================================================
+template <typename Vector, typename Generator = std::minstd_rand0>
+class sessions {
+  public:
+    using Decoder   = decoder<Vector, Generator>;
+    using Container = typename Decoder::Container;
+    using Mode      = typename Decoder::Mode;
+    using Pool      = typename Decoder::Pool;
+    using Clock     = std::chrono::steady_clock;
+
+    /// evicted session consumer (id), the decoder is already released
+    using Evict = std::function<void(uint64_t)>;
+
+    /// constructor
+    /// @param budget  bytes held by the decoders (sessions and released) and the frame pool
+    /// @param timeout idle time before eviction (zero: never)
+    /// @param token
+    /// @param mode
+    explicit sessions(
+      size_t budget,
+      Clock::duration timeout    = Clock::duration::zero(),
+      token::shared::Stamp token = token::get(token::Type::FULL),
+      Mode mode                  = Mode::EAGER)
+      : sessions_{},
+        order_{},
+        spare_{},
+        budget_{budget},
+        memory_{0},
+        evicted_{0},
+        timeout_{timeout},
+        token_{token},
+        mode_{mode},
+        pool_{std::make_shared<codec::pool<Vector>>()},
+        evict_{} {}
+
+    /// push
+    /// @param id       session
+    /// @param capacity generation size (a session keeps the capacity of its first frame)
+    /// @param frame    coded
+    /// @param now      time of use
+    /// @return decoder of the session, nullptr when the capacity does not match
+    Decoder* push(
+      uint64_t id, size_t capacity, Vector frame, Clock::time_point now = Clock::now()) {
+        expire(now);
+        auto it = sessions_.find(id);
+        if (it == sessions_.end())
+            it = open(id, capacity, now);
+        else if (it->second.decoder.capacity() != capacity)
+            return nullptr;
+        // most recently used
+        auto& s = it->second;
+        order_.splice(std::end(order_), order_, s.order);
+        s.used = now;
+        // decode and account
+        s.decoder.push(std::move(frame));
+        account(s);
+        enforce(id);
+        return &s.decoder;
+    }
+
+    /// pop
+    /// @param id session
+    /// @return decoded frames (the session is closed)
+    Container pop(uint64_t id) {
+        auto it = sessions_.find(id);
+        if (it == sessions_.end())
+            return {};
+        auto out = it->second.decoder.pop();
+        close(it);
+        return out;
+    }
+
+    /// erase
+    /// @param id session
+    void erase(uint64_t id) {
+        auto it = sessions_.find(id);
+        if (it != sessions_.end())
+            close(it);
+    }
+
+    /// find
+    /// @param id session
+    /// @return decoder of the session, nullptr when unknown (use order unchanged)
+    Decoder* find(uint64_t id) {
+        auto it = sessions_.find(id);
+        return it == sessions_.end() ? nullptr : &it->second.decoder;
+    }
+
+    /// expire
+    /// @brief evict the sessions idle beyond the timeout
+    /// @param now
+    /// @return number of evicted sessions
+    size_t expire(Clock::time_point now = Clock::now()) {
+        auto count = size_t{0};
+        if (timeout_ == Clock::duration::zero())
+            return count;
+        while (!order_.empty()) {
+            auto it = sessions_.find(order_.front());
+            if (now - it->second.used <= timeout_)
+                break;
+            remove(it);
+            ++count;
+        }
+        return count;
+    }
+
+    /// evict
+    /// @param callback evicted sessions
+    void evict(Evict callback) { evict_ = std::move(callback); }
+
+    /// pool
+    auto& pool() const { return pool_; }
+
+    /// quantity
+    auto size() const { return sessions_.size(); }
+    auto empty() const { return sessions_.empty(); }
+    auto evicted() const { return evicted_; }
+    auto budget() const { return budget_; }
+    void reserve(size_t size) { sessions_.reserve(size); }
+
+    /// memory
+    /// @return bytes held by the decoders (sessions and released) and the free pool frames
+    size_t memory() const { return memory_ + pool_->memory(); }
+
+    /// memory
+    /// @param id session
+    /// @return bytes held by the decoder of the session (zero when unknown)
+    size_t memory(uint64_t id) const {
+        auto it = sessions_.find(id);
+        return it == sessions_.end() ? size_t{0} : it->second.memory;
+    }
+
+    /// spare
+    /// @return bytes held by the released decoders
+    size_t spare() const {
+        auto bytes = size_t{0};
+        for (auto& [capacity, decoders] : spare_)
+            for (auto& d : decoders)
+                bytes += d.memory;
+        return bytes;
+    }
+
+  private:
+    /// session (decoder, accounted bytes, last use and position in the use order)
+    struct session {
+        Decoder decoder;
+        size_t memory;
+        Clock::time_point used;
+        std::list<uint64_t>::iterator order;
+    };
+
+    /// released decoder
+    struct released {
+        Decoder decoder;
+        size_t memory;
+    };
+
+    std::unordered_map<uint64_t, session> sessions_;
+    /// use order (least recent first)
+    std::list<uint64_t> order_;
+    /// released decoders by capacity (most recent last)
+    std::unordered_map<size_t, std::vector<released>> spare_;
+    /// context
+    size_t budget_;
+    size_t memory_;
+    size_t evicted_;
+    /// property
+    Clock::duration timeout_;
+    token::shared::Stamp token_;
+    Mode mode_;
+    Pool pool_;
+    Evict evict_;
+
+    /// open
+    /// @brief session with a released decoder of the same capacity or a new one
+    auto open(uint64_t id, size_t capacity, Clock::time_point now) {
+        auto decoder = Decoder();
+        auto memory  = size_t{0};
+        auto spare   = spare_.find(capacity);
+        if (spare != spare_.end() && !spare->second.empty()) {
+            decoder = std::move(spare->second.back().decoder);
+            memory  = spare->second.back().memory;
+            spare->second.pop_back();
+        } else {
+            decoder = Decoder(capacity, token_, mode_);
+            decoder.pool(pool_);
+            memory  = decoder.memory();
+            memory_ += memory;
+        }
+        order_.push_back(id);
+        auto order = std::prev(std::end(order_));
+        return sessions_.emplace(id, session{std::move(decoder), memory, now, order})
+          .first;
+    }
+
+    /// close
+    /// @brief release the decoder of a session (kept for the next session of its capacity)
+    template <typename Iterator>
+    void close(Iterator it) {
+        auto& s = it->second;
+        s.decoder.clear();
+        account(s);
+        spare_[s.decoder.capacity()].push_back({std::move(s.decoder), s.memory});
+        order_.erase(s.order);
+        sessions_.erase(it);
+    }
+
+    /// remove
+    /// @brief evict a session
+    template <typename Iterator>
+    void remove(Iterator it) {
+        auto id = it->first;
+        close(it);
+        ++evicted_;
+        if (evict_)
+            evict_(id);
+    }
+
+    /// account
+    /// @brief update the bytes held by a session decoder
+    void account(session& s) {
+        auto memory = s.decoder.memory();
+        memory_     = memory_ + memory - s.memory;
+        s.memory    = memory;
+    }
+
+    /// enforce
+    /// @brief free pool frames, drop released decoders then evict the least recent sessions
+    ///        (but the current one) while the budget is exceeded
+    void enforce(uint64_t current) {
+        while (memory() > budget_) {
+            if (pool_->memory()) {
+                pool_->shrink(budget_ > memory_ ? budget_ - memory_ : 0);
+                continue;
+            }
+            if (drop())
+                continue;
+            if (order_.empty() || order_.front() == current)
+                break;
+            remove(sessions_.find(order_.front()));
+        }
+    }
+
+    /// drop
+    /// @brief free a released decoder
+    /// @return false when there is none
+    bool drop() {
+        for (auto& [capacity, decoders] : spare_) {
+            if (decoders.empty())
+                continue;
+            memory_ -= decoders.back().memory;
+            decoders.pop_back();
+            return true;
+        }
+        return false;
+    }
+};
+} // namespace share::codec
@@ -0,0 +1,65 @@
+/// ===============================================================================================
+/// @file      : span.hpp                                                  |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace share::codec {
+
+/// span
+/// @brief
+/// non owning view of contiguous bytes (std::span<const uint8_t> stand-in),
+/// the viewed memory must outlive the span
+class span {
+  public:
+    using value_type     = uint8_t;
+    using const_iterator = const uint8_t*;
+    using iterator       = const_iterator;
+
+    /// constructors
+    constexpr span() : data_{nullptr}, size_{0} {}
+    constexpr span(const uint8_t* data, size_t size) : data_{data}, size_{size} {}
+
+    /// constructor
+    /// @param buffer contiguous container of bytes
+    template <
+      typename Buffer,
+      typename = std::enable_if_t<
+        std::is_same_v<std::decay_t<decltype(*std::declval<const Buffer&>().data())>, uint8_t>>>
+    span(const Buffer& buffer) : data_{buffer.data()}, size_{buffer.size()} {}
+
+    /// subspan
+    /// @param offset
+    /// @param count
+    constexpr span subspan(size_t offset, size_t count) const { return {data_ + offset, count}; }
+
+    /// iterators
+    constexpr auto begin() const { return data_; }
+    constexpr auto end() const { return data_ + size_; }
+
+    /// access
+    constexpr auto data() const { return data_; }
+    constexpr auto& operator[](size_t n) const { return data_[n]; }
+
+    /// quantity
+    constexpr auto size() const { return size_; }
+    constexpr auto empty() const { return size_ == 0; }
+
+  private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+/// scatter-gather list (message is the concatenation of the buffers)
+using buffers = std::vector<span>;
+
+} // namespace share::codec
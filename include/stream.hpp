@@ -23,11 +23,17 @@ class istream {
     static constexpr int DEFAULT_CAPACITY = 100;
 
   public:
+    /// coding modes
+    /// - RANDOM     : every frame is a random combination
+    /// - SYSTEMATIC : source frames are sent unchanged first, then random combinations
+    enum class Mode { RANDOM, SYSTEMATIC };
+
     /// constructor
-    /// @param capacity
     /// @param token
-    explicit istream(token::shared::Stamp token = token::get(token::Type::FULL))
-      : encoder_{DEFAULT_CAPACITY, token} {}
+    /// @param mode
+    explicit istream(
+      token::shared::Stamp token = token::get(token::Type::FULL), Mode mode = Mode::RANDOM)
+      : encoder_{DEFAULT_CAPACITY, token}, mode_{mode}, sent_{0} {}
 
     /// set
     /// @param data
@@ -56,21 +62,100 @@ class istream {
         helpers::copy(Size(encoder_.size() + 1), std::rbegin(frame));
         encoder_.push(frame);
 
+        sent_ = 0;
+        return encoder_.size() + redundancy;
+    }
+
+    /// set
+    /// @brief zero-copy, the message memory must outlive the stream (frames are views),
+    ///        only the frames with the size header, the tail information or crossing a
+    ///        buffer boundary are copied
+    /// @param data       message
+    /// @param framesize
+    /// @param redundancy
+    Size set(span data, Size framesize, Size redundancy = 0) {
+        return set(buffers{data}, framesize, redundancy);
+    }
+
+    /// set
+    /// @brief zero-copy, see above
+    /// @param data       scatter-gather list (message is the concatenation of the buffers)
+    /// @param framesize
+    /// @param redundancy
+    Size set(const buffers& data, Size framesize, Size redundancy = 0) {
+        // helpers
+        Size size   = std::max(framesize - encoder_.HEADER_SIZE, sizeof(Size));
+        auto length = size_t{0};
+        for (auto& buffer : data)
+            length += buffer.size();
+
+        // layout: [head information][data][padding][tail information]
+        auto total  = sizeof(Size) + length;
+        auto frames = (total + sizeof(Size) + size - 1) / size;
+        auto buffer = std::begin(data);
+        auto offset = size_t{0};
+        auto read   = [&](auto it, size_t count) {
+            while (count && buffer != std::end(data)) {
+                auto n = std::min(count, buffer->size() - offset);
+                it     = std::copy_n(std::next(buffer->begin(), offset), n, it);
+                count -= n;
+                offset += n;
+                if (offset == buffer->size())
+                    ++buffer, offset = 0;
+            }
+            return it;
+        };
+        for (auto n = size_t{0}; n < frames; ++n) {
+            auto last = (n + 1 == frames);
+            // frame inside a buffer, view
+            while (buffer != std::end(data) && buffer->empty())
+                ++buffer;
+            if (n > 0 && !last && buffer != std::end(data) && offset + size <= buffer->size()) {
+                encoder_.push(buffer->subspan(offset, size));
+                if ((offset += size) == buffer->size())
+                    ++buffer, offset = 0;
+                continue;
+            }
+            // frame with head, tail or across buffers, copy
+            auto frame = Vector(size, 0);
+            auto fit   = std::begin(frame);
+            if (n == 0)
+                fit = helpers::copy(Size(length), fit);
+            auto first = std::max(n * size, sizeof(Size));
+            auto end   = std::min(n * size + size, total);
+            if (first < end)
+                read(fit, end - first);
+            if (last)
+                helpers::copy(Size(encoder_.size() + 1), std::rbegin(frame));
+            encoder_.push(std::move(frame));
+        }
+
+        sent_ = 0;
         return encoder_.size() + redundancy;
     }
 
     /// pop
     /// @return coded vector
-    Vector pop() { return std::move(encoder_.pop(1).front()); }
+    Vector pop() {
+        if (mode_ == Mode::SYSTEMATIC && sent_ < encoder_.size())
+            return std::move(encoder_.systematic(sent_++, 1).front());
+        return std::move(encoder_.pop(1).front());
+    }
+
+    /// mode
+    auto mode() const { return mode_; }
 
   protected:
     encoder<Vector> encoder_;
+    Mode mode_;
+    size_t sent_;
 };
 
 
 /// ===============================================================================================
 /// ostream
 /// @brief
+///   decodes both istream modes, systematic frames are placed as identity rows
 /// ===============================================================================================
 template <typename Vector = std::vector<uint8_t>, typename Size = uint32_t>
 class ostream {
@@ -91,6 +176,8 @@ class ostream {
     size_t push(Vector frame) {
         // digest data
         decoder_.push(std::move(frame));
+        if (decoder_.empty())
+            return 0;
 
         // check tail
         auto count = Size{0};
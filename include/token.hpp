@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <random>
 #include <vector>
 
 // Codec Token
@@ -35,10 +36,16 @@ namespace token {
     /// - Full
     enum class Type { SPARSE, STREAM, MESSAGE, FULL };
 
+    /// Uniform Density of the default Stamps (SPARSE and FULL, same density for every seed)
+    /// @param type
+    inline constexpr Density uniform(Type type) {
+        return type == Type::SPARSE ? Density{31, 127} : Density{255, 255};
+    }
+
     /// Defaults Stamps foreach Type
     inline const std::map<Type, std::shared_ptr<const Stamp>> DEFAULT{
-        {Type::SPARSE, std::make_shared<const Stamp>(256, Density{31, 127})},
-        {Type::FULL,   std::make_shared<const Stamp>(256, Density{255, 255})}};
+        {Type::SPARSE, std::make_shared<const Stamp>(256, uniform(Type::SPARSE))},
+        {Type::FULL,   std::make_shared<const Stamp>(256, uniform(Type::FULL))}};
 
     /// Templates Stamps foreach Type
     inline const std::map<Type, std::pair<const Density, const Density>> TEMPLATE{
@@ -0,0 +1,351 @@
+/// ===============================================================================================
+/// @file      : window.hpp                                                |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+#include "seed.hpp"
+#include "token.hpp"
+#include "helpers/combine.hpp"
+#include "helpers/copy.hpp"
+#include "helpers/gf8.hpp"
+
+namespace share::codec::window {
+
+/// frame layout (little endian): [payload][first:4][count:2][seed:4]
+///   combination of the source frames [first, first + count), first is the encoder window
+///   start, a systematic seed marks the source frame first + count - 1 carried unchanged
+static constexpr size_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+/// ===============================================================================================
+/// encoder
+/// @brief
+///   sliding window encoder, source frames (all of the same payload length) are pushed
+///   continuously and combinations mix the frames of the window, frames leave the window
+///   when acknowledged or beyond the span
+/// ===============================================================================================
+template <typename Vector, typename Random = std::random_device, typename Generator = std::minstd_rand0>
+class encoder {
+  public:
+    /// constructor
+    /// @param span   maximum frames in the window
+    /// @param length payload length of the frames
+    /// @param token
+    encoder(size_t span, size_t length, token::shared::Stamp token = token::get(token::Type::FULL))
+      : window_{},
+        first_{0},
+        span_{std::min(span, size_t{0xFFFF})},
+        length_{length},
+        token_{token} {}
+
+    /// push
+    /// @brief add a source frame to the window (the oldest leaves when the span is exceeded)
+    /// @param frame
+    /// @return index of the frame in the stream
+    /// @throw std::range_error when the frame length is not the payload length
+    uint32_t push(Vector frame) {
+        if (frame.size() != length_)
+            throw std::range_error("frame length differs from the payload length");
+        window_.push_back(std::move(frame));
+        while (window_.size() > span_) {
+            window_.pop_front();
+            ++first_;
+        }
+        return first_ + uint32_t(window_.size() - 1);
+    }
+
+    /// ack
+    /// @brief the receiver delivered the frames before index
+    /// @param index
+    void ack(uint32_t index) {
+        while (!window_.empty() && int32_t(index - first_) > 0) {
+            window_.pop_front();
+            ++first_;
+        }
+    }
+
+    /// systematic
+    /// @param index of a frame in the window
+    /// @return source frame unchanged (empty when out of the window)
+    Vector systematic(uint32_t index) const {
+        auto offset = size_t(index - first_);
+        if (offset >= window_.size())
+            return {};
+        auto frame = Vector();
+        frame.reserve(window_[offset].size() + HEADER_SIZE);
+        frame.assign(std::begin(window_[offset]), std::end(window_[offset]));
+        attach(frame, first_, uint16_t(offset + 1), seed::systematic(offset));
+        return frame;
+    }
+
+    /// pop
+    /// @return combination of the window frames (empty when the window is empty)
+    Vector pop() const {
+        if (window_.empty())
+            return {};
+        thread_local auto seeds = std::mt19937{Random{}()};
+        // coefficients (bad seeds rejected)
+        auto coef = Vector(window_.size());
+        auto seed = uint32_t{0};
+        do {
+            do {
+                seed = uint32_t(seeds());
+            } while (seed::reserved(seed));
+        } while (helpers::coefficients<Generator>(
+                   seed, (*token_)[uint8_t(seed)].first, (*token_)[uint8_t(seed)].second, coef)
+                 == 0);
+        // combination
+        auto frame = Vector();
+        frame.reserve(length_ + HEADER_SIZE);
+        frame.resize(length_);
+        for (size_t j = 0; j < window_.size(); ++j)
+            helpers::gf8::muladd(frame, window_[j], coef[j]);
+        attach(frame, first_, uint16_t(window_.size()), seed);
+        return frame;
+    }
+
+    /// quantity
+    auto first() const { return first_; }
+    auto size() const { return window_.size(); }
+    auto span() const { return span_; }
+    auto length() const { return length_; }
+    auto empty() const { return window_.empty(); }
+
+  private:
+    std::deque<Vector> window_;
+    uint32_t first_;
+    size_t span_;
+    size_t length_;
+    token::shared::Stamp token_;
+
+    /// attach
+    static void attach(Vector& frame, uint32_t first, uint16_t count, uint32_t seed) {
+        frame.resize(frame.size() + HEADER_SIZE);
+        auto it = std::prev(std::end(frame), HEADER_SIZE);
+        it      = helpers::copy(first, it);
+        it      = helpers::copy(count, it);
+        it      = helpers::copy(seed, it);
+    }
+};
+
+/// ===============================================================================================
+/// decoder
+/// @brief
+///   sliding window decoder, source frames are delivered in order as soon as they are decoded,
+///   memory is bounded by the span (basis rows and the history of delivered frames)
+/// ===============================================================================================
+template <typename Vector, typename Generator = std::minstd_rand0>
+class decoder {
+  public:
+    /// constructor
+    /// @param span   maximum frames in the window (as the encoder)
+    /// @param length payload length of the frames (as the encoder)
+    /// @param token
+    decoder(size_t span, size_t length, token::shared::Stamp token = token::get(token::Type::FULL))
+      : basis_{},
+        ready_{},
+        history_{},
+        next_{0},
+        lost_{0},
+        length_{length},
+        span_{span},
+        token_{token} {}
+
+    /// push
+    /// @brief frames of another payload length or combining more frames than the span
+    ///        are dropped
+    /// @param frame coded
+    /// @return number of frames ready to pop
+    size_t push(Vector frame) {
+        if (frame.size() < HEADER_SIZE)
+            return ready_.size();
+        // header
+        auto first = uint32_t{0};
+        auto count = uint16_t{0};
+        auto seed  = uint32_t{0};
+        auto it    = std::prev(std::end(frame), HEADER_SIZE);
+        it         = helpers::copy(it, first);
+        it         = helpers::copy(it, count);
+        it         = helpers::copy(it, seed);
+        frame.resize(frame.size() - HEADER_SIZE);
+        if (count > span_ || frame.size() != length_)
+            return ready_.size();
+        // frames before first left the encoder window undecoded (lost)
+        if (int32_t(first - next_) > 0)
+            skip(first);
+        // coefficients
+        auto r = row{first, Vector(count), std::move(frame)};
+        if (seed::reserved(seed)) {
+            if (count == 0)
+                return ready_.size();
+            r.coef.back() = 1;
+        } else {
+            auto field    = (*token_)[uint8_t(seed)].first;
+            auto sparsity = (*token_)[uint8_t(seed)].second;
+            helpers::coefficients<Generator>(seed, field, sparsity, r.coef);
+        }
+        if (reduce(std::move(r)))
+            deliver();
+        return ready_.size();
+    }
+
+    /// pop
+    /// @return next source frame in order (empty when none is ready)
+    Vector pop() {
+        if (ready_.empty())
+            return {};
+        auto frame = std::move(ready_.front());
+        ready_.pop_front();
+        return frame;
+    }
+
+    /// quantity
+    auto ready() const { return ready_.size(); }
+    /// index of the next frame to deliver (acknowledge value)
+    auto next() const { return next_; }
+    /// frames skipped because they could not be decoded
+    auto lost() const { return lost_; }
+    /// rows waiting for decoding
+    auto pending() const { return basis_.size(); }
+    auto length() const { return length_; }
+
+  private:
+    /// row (combination of the source frames [first, first + coef.size()))
+    struct row {
+        uint32_t first;
+        Vector coef;
+        Vector data;
+
+        auto end() const { return first + uint32_t(coef.size()); }
+    };
+
+    /// basis (reduced echelon, by pivot)
+    std::map<uint32_t, row> basis_;
+    /// delivered frames (ready to pop and known history)
+    std::deque<Vector> ready_;
+    std::deque<Vector> history_;
+    uint32_t next_;
+    size_t lost_;
+
+    /// property
+    size_t length_;
+    size_t span_;
+    token::shared::Stamp token_;
+
+    /// relative position (wrap around safe)
+    static int32_t distance(uint32_t from, uint32_t to) { return int32_t(to - from); }
+
+    /// muladd
+    /// @brief (dst += src * factor), the dst range grows to cover src
+    static void muladd(row& dst, const row& src, uint8_t factor) {
+        auto first = distance(dst.first, src.first) < 0 ? src.first : dst.first;
+        auto end   = distance(dst.end(), src.end()) > 0 ? src.end() : dst.end();
+        if (first != dst.first || end != dst.end()) {
+            auto coef = Vector(size_t(end - first));
+            auto pos  = std::next(std::begin(coef), dst.first - first);
+            std::copy(std::begin(dst.coef), std::end(dst.coef), pos);
+            dst.coef  = std::move(coef);
+            dst.first = first;
+        }
+        helpers::gf8::muladd(
+          dst.coef.data() + (src.first - dst.first), src.coef.data(), src.coef.size(), factor);
+        helpers::gf8::muladd(dst.data, src.data, factor);
+    }
+
+    /// trim
+    /// @brief remove leading and trailing zero coefficients
+    static bool trim(row& r) {
+        auto lead = std::find_if(std::begin(r.coef), std::end(r.coef), [](auto v) { return v; });
+        if (lead == std::end(r.coef))
+            return false;
+        auto tail = std::find_if(std::rbegin(r.coef), std::rend(r.coef), [](auto v) { return v; });
+        r.first += uint32_t(std::distance(std::begin(r.coef), lead));
+        r.coef.erase(tail.base(), std::end(r.coef));
+        r.coef.erase(std::begin(r.coef), lead);
+        return true;
+    }
+
+    /// reduce
+    /// @brief on the fly gauss-jordan step of a new row
+    /// @return true when the row is innovative
+    bool reduce(row r) {
+        // known frames (delivered)
+        for (auto c = r.first; distance(c, next_) > 0 && distance(c, r.end()) > 0; ++c) {
+            auto factor = r.coef[c - r.first];
+            if (factor == 0)
+                continue;
+            auto back = size_t(next_ - c);
+            if (back > history_.size())
+                return false;
+            helpers::gf8::muladd(r.data, history_[history_.size() - back], factor);
+            r.coef[c - r.first] = 0;
+        }
+        if (!trim(r))
+            return false;
+        // forward elimination (basis rows only reach columns at the right of the pivot)
+        for (auto it = basis_.lower_bound(r.first); it != basis_.end(); ++it) {
+            if (distance(it->first, r.end()) <= 0)
+                break;
+            auto factor = r.coef[it->first - r.first];
+            if (factor != 0)
+                muladd(r, it->second, factor);
+        }
+        if (!trim(r))
+            return false;
+        // diagonal unification
+        auto pivot  = r.first;
+        auto factor = helpers::gf8::div(1, r.coef.front());
+        helpers::gf8::mul(r.coef, factor);
+        helpers::gf8::mul(r.data, factor);
+        // backward elimination
+        for (auto& [p, b] : basis_) {
+            if (distance(b.first, pivot) < 0 || distance(pivot, b.end()) <= 0)
+                continue;
+            auto factor = b.coef[pivot - b.first];
+            if (factor != 0) {
+                muladd(b, r, factor);
+                trim(b);
+            }
+        }
+        basis_.emplace(pivot, std::move(r));
+        return true;
+    }
+
+    /// deliver
+    /// @brief move the decoded frames at the front of the window to the ready queue
+    void deliver() {
+        for (auto it = basis_.find(next_); it != basis_.end(); it = basis_.find(next_)) {
+            if (it->second.coef.size() != 1)
+                break;
+            history_.push_back(it->second.data);
+            ready_.push_back(std::move(it->second.data));
+            basis_.erase(it);
+            ++next_;
+            while (history_.size() > span_)
+                history_.pop_front();
+        }
+    }
+
+    /// skip
+    /// @brief give up the frames before first (rows pivoting on them are dropped)
+    void skip(uint32_t first) {
+        deliver();
+        if (distance(next_, first) <= 0)
+            return;
+        for (auto it = basis_.begin(); it != basis_.end() && distance(it->first, first) > 0;)
+            it = basis_.erase(it);
+        lost_ += size_t(first - next_);
+        next_ = first;
+        history_.clear();
+        deliver();
+    }
+};
+} // namespace share::codec::window
@@ -0,0 +1,30 @@
+/// ===============================================================================================
+/// @file      : codec_share_fixture.hpp                                   |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "container.hpp"
+
+/// generate
+/// @brief frames of random bytes shared by the tests and benchmarks (same frames for a seed)
+/// @param width  frame size
+/// @param height number of frames
+/// @param seed
+inline auto generate(size_t width, size_t height, uint32_t seed = 1) {
+    auto gen  = std::mt19937{seed};
+    auto data = share::codec::container<std::vector<uint8_t>>();
+    for (size_t i = 0; i < height; ++i) {
+        auto frame = std::vector<uint8_t>(width);
+        std::generate(std::begin(frame), std::end(frame), [&gen]() { return uint8_t(gen()); });
+        data.push_back(std::move(frame));
+    }
+    return data;
+}
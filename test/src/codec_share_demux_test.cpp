@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "demux.hpp"
+#include "encoder.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+TEST(codec_shared_demux, header_test) {
+    auto frame = Vector(10, 1);
+    for (auto byte : {4, 3, 2, 1})
+        frame.push_back(uint8_t(byte));
+    share::codec::header::attach(frame, 0xABCD, 7);
+    EXPECT_EQ(frame.size(), 10 + share::codec::header::SIZE);
+
+    auto head = share::codec::header{};
+    EXPECT_TRUE(share::codec::header::parse(frame, head));
+    EXPECT_EQ(head.id, 0xABCDu);
+    EXPECT_EQ(head.size, 7u);
+    EXPECT_EQ(head.length, 10u);
+    EXPECT_EQ(head.seed, 0x01020304u);
+
+    share::codec::header::detach(frame);
+    EXPECT_EQ(frame.size(), 14u);
+    EXPECT_FALSE(share::codec::header::parse(frame, head));
+}
+
+TEST(codec_shared_demux, capacity_test) {
+    // the header size field holds at most header::CAPACITY frames
+    auto buffer  = Vector(share::codec::header::CAPACITY + 1, 1);
+    auto encoder = share::codec::encoder<Vector>();
+    encoder.push(share::codec::span{buffer}, 1);
+    using Exception = share::codec::container<Vector>::exception;
+    EXPECT_THROW(encoder.pop(1, 7), Exception);
+}
+
+TEST(codec_shared_demux, interleave_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto inputs  = std::vector<share::codec::container<Vector>>{};
+    auto streams = std::vector<share::codec::container<Vector>>{};
+    for (uint32_t id = 0; id < 8; ++id) {
+        inputs.push_back(generate(100 + id, 10 + id, id));
+        auto encoder = share::codec::encoder<Vector>(inputs.back(), token);
+        streams.push_back(encoder.pop(inputs.back().size() + 4, id));
+    }
+    // interleave the frames of all generations
+    auto demux = share::codec::demux<Vector>(token);
+    auto done  = std::vector<share::codec::container<Vector>>(inputs.size());
+    for (size_t n = 0; n < streams.back().size(); ++n) {
+        for (uint32_t id = 0; id < streams.size(); ++id) {
+            if (n >= streams[id].size())
+                continue;
+            // late frames of a decoded generation are dropped
+            if (!done[id].empty()) {
+                EXPECT_EQ(demux.push(std::move(streams[id][n])), nullptr);
+                continue;
+            }
+            auto decoder = demux.push(std::move(streams[id][n]));
+            ASSERT_NE(decoder, nullptr);
+            if (decoder->full() && done[id].empty())
+                done[id] = demux.pop(id);
+        }
+    }
+    for (size_t id = 0; id < inputs.size(); ++id)
+        EXPECT_EQ(done[id], inputs[id]);
+    EXPECT_TRUE(demux.empty());
+    // invalid header
+    EXPECT_EQ(demux.push(Vector(20, 0)), nullptr);
+}
+
+TEST(codec_shared_demux, retired_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto input   = generate(100, 10, 1);
+    auto encoder = share::codec::encoder<Vector>(input, token);
+    auto factory = [token](uint32_t, size_t size) {
+        return share::codec::decoder<Vector>(size, token);
+    };
+    // two retired ids at most
+    auto demux = share::codec::demux<Vector>(factory, 2);
+    for (uint32_t id = 0; id < 3; ++id) {
+        for (auto& frame : encoder.pop(input.size() + 2, id))
+            demux.push(std::move(frame));
+        EXPECT_EQ(demux.pop(id), input);
+    }
+    EXPECT_FALSE(demux.retired(0));
+    EXPECT_TRUE(demux.retired(1));
+    EXPECT_TRUE(demux.retired(2));
+    // late frames of retired generations leave no decoder behind
+    EXPECT_EQ(demux.push(encoder.pop(1, 2).front()), nullptr);
+    EXPECT_TRUE(demux.empty());
+    // erased generations are retired too, the oldest id is forgotten
+    EXPECT_NE(demux.push(encoder.pop(1, 3).front()), nullptr);
+    demux.erase(3);
+    EXPECT_TRUE(demux.retired(3));
+    EXPECT_FALSE(demux.retired(1));
+    EXPECT_NE(demux.push(encoder.pop(1, 1).front()), nullptr);
+    EXPECT_EQ(demux.size(), 1u);
+}
+
+TEST(codec_shared_demux, reserve_test) {
+    // only frames that carry a header reserve room for it
+    auto input   = generate(1000, 10, 1);
+    auto encoder = share::codec::encoder<Vector>(input);
+    auto plain   = encoder.pop(1).front();
+    auto framed  = encoder.pop(1, 7).front();
+    EXPECT_LT(plain.capacity(), 1000 + share::codec::header::SIZE);
+    EXPECT_EQ(framed.size(), 1000 + share::codec::header::SIZE);
+}
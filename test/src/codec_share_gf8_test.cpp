@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "helpers/gf8.hpp"
+
+namespace gf8 = share::codec::helpers::gf8;
+
+/// generate
+static auto generate(size_t size) {
+    std::mt19937 engine{size};
+    std::uniform_int_distribution<int> dist{0, 255};
+    std::vector<uint8_t> vec(size);
+    std::generate(std::begin(vec), std::end(vec), [&]() { return uint8_t(dist(engine)); });
+    return vec;
+}
+
+TEST(codec_shared_gf8, kernel_mul_test) {
+    // odd size to cover every tail path
+    auto input = generate(4096 + 63);
+    for (auto& kernel : gf8::kernel::KERNELS) {
+        if (!kernel.supported())
+            continue;
+        for (int m = 0; m < 256; ++m) {
+            auto expected = input;
+            for (auto& val : expected)
+                val = uint8_t(gf8::mul(val, uint8_t(m)));
+            auto output = input;
+            kernel.mul(output.data(), output.size(), uint8_t(m));
+            ASSERT_EQ(output, expected) << kernel.name << " m=" << m;
+        }
+    }
+}
+
+TEST(codec_shared_gf8, kernel_sum_test) {
+    auto a = generate(4096 + 63);
+    auto b = generate(4096 + 31);
+    b.resize(a.size());
+    auto expected = a;
+    for (size_t i = 0; i < a.size(); ++i)
+        expected[i] ^= b[i];
+    for (auto& kernel : gf8::kernel::KERNELS) {
+        if (!kernel.supported())
+            continue;
+        auto output = a;
+        kernel.sum(output.data(), b.data(), output.size());
+        ASSERT_EQ(output, expected) << kernel.name;
+    }
+}
+
+TEST(codec_shared_gf8, kernel_muladd_test) {
+    auto a = generate(4096 + 63);
+    auto b = generate(4096 + 15);
+    b.resize(a.size());
+    for (auto& kernel : gf8::kernel::KERNELS) {
+        if (!kernel.supported())
+            continue;
+        for (int m = 0; m < 256; ++m) {
+            auto expected = a;
+            for (size_t i = 0; i < a.size(); ++i)
+                expected[i] ^= uint8_t(gf8::mul(b[i], uint8_t(m)));
+            auto output = a;
+            kernel.muladd(output.data(), b.data(), output.size(), uint8_t(m));
+            ASSERT_EQ(output, expected) << kernel.name << " m=" << m;
+        }
+    }
+}
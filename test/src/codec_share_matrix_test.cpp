@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "helpers/matrix.hpp"
+
+
+TEST(codec_shared_matrix, layout_test) {
+    auto matrix = share::codec::helpers::matrix(3, 100);
+
+    EXPECT_EQ(matrix.size(), 3u);
+    EXPECT_EQ(matrix.stride(), 128u);
+    for (auto& row : matrix) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(row.data()) % 64, 0u);
+        EXPECT_EQ(row.size(), 100u);
+        EXPECT_TRUE(std::all_of(std::begin(row), std::end(row), [](auto v) { return v == 0; }));
+    }
+}
+
+TEST(codec_shared_matrix, permutation_test) {
+    auto matrix = share::codec::helpers::matrix(0, 10, 2);
+    for (uint8_t i = 0; i < 10; ++i)
+        matrix.push_back(std::vector<uint8_t>(10, i));
+
+    // swaps and rotations move handles only
+    auto first = matrix[0].data();
+    std::swap(matrix[0], matrix[9]);
+    EXPECT_EQ(matrix[9].data(), first);
+    EXPECT_EQ(matrix[0][0], 9);
+    std::rotate(std::begin(matrix), std::prev(std::end(matrix)), std::end(matrix));
+    EXPECT_EQ(matrix[0][0], 0);
+    EXPECT_EQ(matrix[1][0], 9);
+
+    // released rows are reused
+    auto last = matrix.back().data();
+    matrix.pop_back();
+    matrix.push_back(std::vector<uint8_t>(20, 42));
+    EXPECT_EQ(matrix.back().data(), last);
+    EXPECT_EQ(std::count(std::begin(matrix.back()), std::end(matrix.back()), 42), 10);
+
+    // copies are deep
+    auto copy = matrix;
+    copy[0][0] = 7;
+    EXPECT_EQ(matrix[0][0], 0);
+}
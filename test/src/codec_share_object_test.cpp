@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "object.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+static auto generate(size_t length, uint32_t seed) {
+    auto gen  = std::mt19937{seed};
+    auto data = Vector(length);
+    std::generate(std::begin(data), std::end(data), [&gen]() { return uint8_t(gen()); });
+    return data;
+}
+
+TEST(codec_shared_object, layout_test) {
+    auto layout = share::codec::object::layout{1000, 4, 100};
+    EXPECT_EQ(layout.generations(), 3u);
+    EXPECT_EQ(layout.offset(2), 800u);
+    EXPECT_EQ(layout.bytes(2), 200u);
+    EXPECT_EQ(layout.frames(1), 4u);
+    EXPECT_EQ(layout.frames(2), 2u);
+}
+
+TEST(codec_shared_object, empty_layout_test) {
+    using Exception = share::codec::container<Vector>::exception;
+    using Layout    = share::codec::object::layout;
+    auto data       = generate(1000, 1);
+    auto sink       = [](size_t, const uint8_t*, size_t) {};
+    EXPECT_THROW(share::codec::object::encoder<Vector>(data, Layout{0, 0, 100}), Exception);
+    EXPECT_THROW(share::codec::object::encoder<Vector>(data, Layout{0, 4, 0}), Exception);
+    EXPECT_THROW(share::codec::object::decoder<Vector>(Layout{1000, 0, 100}), Exception);
+    EXPECT_THROW(share::codec::object::decoder<Vector>(Layout{1000, 4, 0}, sink), Exception);
+}
+
+TEST(codec_shared_object, sequential_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto data    = generate(10 * 1000 + 37, 1);
+    auto layout  = share::codec::object::layout{data.size(), 16, 100};
+    auto encoder = share::codec::object::encoder<Vector>(data, layout, token);
+    auto decoder = share::codec::object::decoder<Vector>(layout, token);
+    // generations in reverse order, frame by frame
+    for (auto g = encoder.generations(); g-- > 0;) {
+        for (auto& frame : encoder.pop(g, layout.frames(g) + 4))
+            decoder.push(std::move(frame));
+        EXPECT_TRUE(decoder.decoded(g));
+        EXPECT_EQ(decoder.pending(), 0u);
+    }
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), data);
+}
+
+TEST(codec_shared_object, parallel_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto workers = std::make_shared<share::codec::helpers::parallel>(3);
+    auto data    = generate(64 * 1000 + 1, 2);
+    auto layout  = share::codec::object::layout{data.size(), 20, 250};
+    auto encoder = share::codec::object::encoder<Vector>(data, layout, token, workers);
+    auto decoder = share::codec::object::decoder<Vector>(layout, token, workers);
+    auto batches = encoder.pop(0, encoder.generations(), 3);
+    ASSERT_EQ(batches.size(), encoder.generations());
+    // interleave the frames of all generations in one push
+    auto frames = share::codec::container<Vector>();
+    for (size_t n = 0; n < layout.k + 3; ++n)
+        for (auto& batch : batches)
+            if (n < batch.size())
+                frames.push_back(std::move(batch[n]));
+    EXPECT_EQ(decoder.push(std::move(frames)), encoder.generations());
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.data(), data);
+    // late and invalid frames are ignored
+    EXPECT_EQ(decoder.push(encoder.pop(0, 1).front()), encoder.generations());
+    EXPECT_EQ(decoder.push(Vector(20, 0)), encoder.generations());
+}
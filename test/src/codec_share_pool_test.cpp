@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "pool.hpp"
+
+/// counting allocator (global replacement)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static std::atomic<size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++allocations;
+    auto alignment = static_cast<std::size_t>(align);
+    if (auto ptr = std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1)))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+
+TEST(codec_shared_pool, recycle_test) {
+    using Vector = std::vector<uint8_t>;
+
+    auto pool  = share::codec::pool<Vector>(2);
+    auto frame = pool.frame(10, 20);
+    EXPECT_EQ(frame, Vector(10, 0));
+    EXPECT_GE(frame.capacity(), 20u);
+
+    auto data = frame.data();
+    frame[0]  = 1;
+    pool.recycle(std::move(frame));
+    EXPECT_EQ(pool.size(), 1u);
+    frame = pool.frame(5);
+    EXPECT_EQ(frame.data(), data);
+    EXPECT_EQ(frame, Vector(5, 0));
+
+    // limit
+    pool.recycle(share::codec::container<Vector>(std::vector<Vector>(3, Vector(1))));
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.memory(), 2u);
+
+    // shrink
+    pool.shrink(1);
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(pool.memory(), 1u);
+    pool.frame(1);
+    EXPECT_EQ(pool.memory(), 0u);
+}
+
+TEST(codec_shared_pool, huge_allocator_test) {
+    using Vector = std::vector<uint8_t, share::codec::huge_allocator<uint8_t>>;
+
+    auto frame = Vector(size_t{3} << 20, 1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(frame.data()) % (size_t{1} << 21), 0u);
+    auto small = Vector(100, 1);
+    EXPECT_EQ(small.size(), 100u);
+}
+
+TEST(codec_shared_pool, steady_state_test) {
+    using Vector  = std::vector<uint8_t>;
+    using Decoder = share::codec::decoder<Vector>;
+
+    auto gen   = std::mt19937{3};
+    auto input = share::codec::container<Vector>();
+    for (auto i = 0; i < 20; ++i) {
+        auto frame = Vector(1000);
+        std::generate(std::begin(frame), std::end(frame), [&gen]() { return uint8_t(gen()); });
+        input.push_back(std::move(frame));
+    }
+    auto token = share::codec::token::get(share::codec::token::Type::FULL);
+    for (auto mode : {Decoder::Mode::EAGER, Decoder::Mode::DEFERRED}) {
+        auto pool    = std::make_shared<share::codec::pool<Vector>>();
+        auto encoder = share::codec::encoder<Vector>(input, token);
+        auto decoder = Decoder(input.size(), token, mode);
+        encoder.pool(pool);
+        decoder.pool(pool);
+
+        auto decoded = size_t{0};
+        auto round   = [&]() {
+            decoder.push(encoder.pop(input.size() + 4));
+            auto output = decoder.pop();
+            decoded += (output == input);
+            decoder.recycle(std::move(output));
+        };
+        // warm-up
+        for (auto i = 0; i < 4; ++i)
+            round();
+        // steady state
+        auto before = allocations.load();
+        for (auto i = 0; i < 16; ++i)
+            round();
+        EXPECT_EQ(allocations.load() - before, 0u);
+        EXPECT_EQ(decoded, 20u);
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <future>
+#include <random>
+#include <thread>
+
+#include "receiver.hpp"
+#include "stream.hpp"
+#include "helpers/queue.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+TEST(codec_shared_receiver, queue_test) {
+    auto queue = share::codec::helpers::queue<size_t>(100);
+    EXPECT_EQ(queue.capacity(), 128u);
+    // full and empty ring
+    for (size_t i = 0; i < queue.capacity(); ++i)
+        EXPECT_TRUE(queue.push(i));
+    auto value = size_t{1000};
+    EXPECT_FALSE(queue.push(value));
+    EXPECT_EQ(value, 1000u);
+    for (size_t i = 0; i < queue.capacity(); ++i) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(codec_shared_receiver, producers_test) {
+    constexpr size_t PRODUCERS = 4;
+    constexpr size_t COUNT     = 20000;
+    auto queue     = share::codec::helpers::queue<size_t>(64);
+    auto producers = std::vector<std::thread>();
+    for (size_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (size_t i = 0; i < COUNT; ++i) {
+                auto value = p * COUNT + i;
+                while (!queue.push(value))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    // every value exactly once, in order per producer
+    auto last  = std::vector<size_t>(PRODUCERS, 0);
+    auto total = size_t{0};
+    for (auto value = size_t{0}; total < PRODUCERS * COUNT;) {
+        if (!queue.pop(value))
+            continue;
+        auto p = value / COUNT;
+        EXPECT_EQ(value % COUNT, last[p]++);
+        ++total;
+    }
+    for (auto& producer : producers)
+        producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(codec_shared_receiver, decode_test) {
+    auto gen     = std::mt19937{5};
+    auto message = Vector(50000);
+    std::generate(std::begin(message), std::end(message), [&gen]() { return uint8_t(gen()); });
+    auto in         = share::codec::istream<Vector>();
+    auto redundancy = 5u;
+    auto size       = in.set(message, 1000, redundancy);
+    // frames from two receive threads
+    auto frames = std::vector<Vector>();
+    for (size_t i = 0; i < size; ++i)
+        frames.push_back(in.pop());
+    auto promise  = std::promise<Vector>();
+    auto result   = promise.get_future();
+    auto receiver = share::codec::receiver<Vector>(
+      [&promise](Vector decoded) { promise.set_value(std::move(decoded)); }, size - redundancy);
+    auto threads = std::vector<std::thread>();
+    for (size_t t = 0; t < 2; ++t) {
+        threads.emplace_back([&, t]() {
+            for (auto i = t; i < frames.size(); i += 2)
+                EXPECT_TRUE(receiver.push(std::move(frames[i])));
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(result.get(), message);
+    EXPECT_EQ(receiver.decoded(), 1u);
+    EXPECT_EQ(receiver.dropped(), 0u);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "decoder.hpp"
+#include "demux.hpp"
+#include "encoder.hpp"
+#include "recoder.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+TEST(codec_shared_recoder, relay_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto input   = generate(500, 40, 1);
+    auto encoder = share::codec::encoder<Vector>(input, token);
+    auto recoder = share::codec::recoder<Vector>(input.size(), token);
+    auto decoder = share::codec::decoder<Vector>(input.size(), token);
+    // relay at full rank, the decoder only sees recoded frames
+    EXPECT_EQ(recoder.push(encoder.pop(input.size() + 5)), input.size());
+    EXPECT_TRUE(recoder.full());
+    EXPECT_EQ(decoder.push(recoder.pop(input.size() + 2)), input.size());
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+TEST(codec_shared_recoder, partial_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto input   = generate(300, 30, 2);
+    auto encoder = share::codec::encoder<Vector>(input, token);
+    auto recoder = share::codec::recoder<Vector>(input.size(), token);
+    auto decoder = share::codec::decoder<Vector>(input.size(), token);
+    // relay at partial rank (systematic and coded frames), recoded frames of a recoder
+    EXPECT_EQ(recoder.push(encoder.systematic(0, 10)), 10u);
+    EXPECT_EQ(recoder.push(encoder.pop(10)), 10u);
+    auto second = share::codec::recoder<Vector>(input.size(), token);
+    EXPECT_EQ(second.push(recoder.pop(25)), 20u);
+    EXPECT_EQ(second.rank(), 20u);
+    EXPECT_EQ(decoder.push(second.pop(30)), 20u);
+    EXPECT_FALSE(decoder.full());
+    // the rest from the source
+    EXPECT_EQ(decoder.push(encoder.pop(15)), 10u);
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+TEST(codec_shared_recoder, binary_test) {
+    using Stamp   = share::codec::token::Stamp;
+    using Density = share::codec::token::Density;
+    auto token    = std::make_shared<const Stamp>(256, Density{1, 127});
+    auto input    = generate(200, 50, 3);
+    auto encoder  = share::codec::encoder<Vector>(input, token);
+    auto recoder  = share::codec::recoder<Vector>(input.size(), token);
+    auto decoder  = share::codec::decoder<Vector>(input.size(), token);
+    recoder.push(encoder.pop(4 * input.size()));
+    EXPECT_TRUE(recoder.full());
+    for (auto& frame : recoder.pop(4 * input.size())) {
+        decoder.push(std::move(frame));
+        if (decoder.full())
+            break;
+    }
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+TEST(codec_shared_recoder, header_test) {
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto input   = generate(100, 8, 4);
+    auto encoder = share::codec::encoder<Vector>(input, token);
+    auto recoder = share::codec::recoder<Vector>(input.size(), token);
+    auto demux   = share::codec::demux<Vector>(token);
+    recoder.push(encoder.pop(input.size() + 2));
+    auto decoder = static_cast<share::codec::decoder<Vector>*>(nullptr);
+    for (auto& frame : recoder.pop(input.size() + 2, 7))
+        decoder = demux.push(std::move(frame));
+    ASSERT_NE(decoder, nullptr);
+    EXPECT_TRUE(decoder->full());
+    EXPECT_EQ(demux.pop(7), input);
+}
+
+TEST(codec_shared_recoder, capacity_test) {
+    // the header size field holds at most header::CAPACITY frames
+    auto recoder    = share::codec::recoder<Vector>(share::codec::header::CAPACITY + 1);
+    using Exception = share::codec::container<Vector>::exception;
+    EXPECT_THROW(recoder.pop(1, 7), Exception);
+    EXPECT_TRUE(recoder.pop(1).empty());
+}
+
+TEST(codec_shared_recoder, fieldless_test) {
+    using Stamp   = share::codec::token::Stamp;
+    using Density = share::codec::token::Density;
+    // a token without fields recodes binary combinations (systematic frames relayed)
+    auto token    = std::make_shared<const Stamp>(256, Density{0, 127});
+    auto input    = generate(100, 10, 5);
+    auto encoder  = share::codec::encoder<Vector>(input, token);
+    auto recoder  = share::codec::recoder<Vector>(input.size(), token);
+    auto decoder  = share::codec::decoder<Vector>(input.size(), token);
+    EXPECT_EQ(recoder.push(encoder.systematic(0, input.size())), input.size());
+    for (auto& frame : recoder.pop(8 * input.size())) {
+        decoder.push(std::move(frame));
+        if (decoder.full())
+            break;
+    }
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
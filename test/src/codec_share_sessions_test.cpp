@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "encoder.hpp"
+#include "sessions.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+TEST(codec_shared_sessions, interleave_test) {
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto sessions = share::codec::sessions<Vector>(size_t{1} << 30);
+    auto inputs   = std::vector<share::codec::container<Vector>>{};
+    auto streams  = std::vector<share::codec::container<Vector>>{};
+    for (uint64_t id = 0; id < 6; ++id) {
+        inputs.push_back(generate(200, 20, uint32_t(id)));
+        streams.push_back(share::codec::encoder<Vector>(inputs.back(), token).pop(22));
+    }
+    for (size_t n = 0; n < 22; ++n)
+        for (uint64_t id = 0; id < streams.size(); ++id)
+            ASSERT_NE(sessions.push(id, 20, std::move(streams[id][n])), nullptr);
+    EXPECT_EQ(sessions.size(), inputs.size());
+    EXPECT_GT(sessions.memory(3), 20u * 200u);
+    // closed sessions release their decoder, the next session of the capacity reuses it
+    auto memory = sessions.memory();
+    for (uint64_t id = 0; id < inputs.size(); ++id) {
+        EXPECT_TRUE(sessions.find(id)->full());
+        EXPECT_EQ(sessions.pop(id), inputs[id]);
+    }
+    EXPECT_TRUE(sessions.empty());
+    EXPECT_GT(sessions.spare(), 0u);
+    EXPECT_LT(sessions.memory(), memory);
+    auto spare = sessions.spare();
+    sessions.push(100, 20, share::codec::encoder<Vector>(inputs[0], token).pop(1).front());
+    EXPECT_LT(sessions.spare(), spare);
+    // capacity mismatch
+    EXPECT_EQ(sessions.push(100, 21, Vector(204, 0)), nullptr);
+}
+
+TEST(codec_shared_sessions, budget_test) {
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto input    = generate(1000, 10, 1);
+    auto encoder  = share::codec::encoder<Vector>(input, token);
+    auto evicted  = std::vector<uint64_t>();
+    // about three half decoded sessions
+    auto probe = share::codec::sessions<Vector>(size_t{1} << 30);
+    for (auto& frame : encoder.pop(5))
+        probe.push(0, 10, std::move(frame));
+    auto sessions = share::codec::sessions<Vector>(3 * probe.memory() + 100);
+    sessions.evict([&evicted](uint64_t id) { evicted.push_back(id); });
+    for (uint64_t id = 0; id < 5; ++id)
+        for (auto& frame : encoder.pop(5))
+            sessions.push(id, 10, std::move(frame));
+    // the free frames of the shared pool count against the budget
+    EXPECT_LE(sessions.memory(), sessions.budget());
+    EXPECT_LE(sessions.pool()->memory(), sessions.memory());
+    EXPECT_EQ(sessions.size(), 3u);
+    EXPECT_EQ(sessions.evicted(), 2u);
+    EXPECT_EQ(evicted, (std::vector<uint64_t>{0, 1}));
+    EXPECT_EQ(sessions.find(0), nullptr);
+    EXPECT_NE(sessions.find(4), nullptr);
+}
+
+TEST(codec_shared_sessions, timeout_test) {
+    using Clock   = share::codec::sessions<Vector>::Clock;
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto input    = generate(100, 10, 2);
+    auto encoder  = share::codec::encoder<Vector>(input, token);
+    auto sessions = share::codec::sessions<Vector>(size_t{1} << 30, std::chrono::milliseconds(50));
+    auto now      = Clock::now();
+    sessions.push(1, 10, encoder.pop(1).front(), now);
+    sessions.push(2, 10, encoder.pop(1).front(), now);
+    for (auto i = 0; i < 2; ++i) {
+        now += std::chrono::milliseconds(30);
+        sessions.push(2, 10, encoder.pop(1).front(), now);
+    }
+    EXPECT_EQ(sessions.find(1), nullptr);
+    EXPECT_NE(sessions.find(2), nullptr);
+    EXPECT_EQ(sessions.evicted(), 1u);
+    // idle up to the timeout is kept
+    EXPECT_EQ(sessions.expire(now + std::chrono::milliseconds(50)), 0u);
+    EXPECT_EQ(sessions.expire(now + std::chrono::milliseconds(51)), 1u);
+    EXPECT_TRUE(sessions.empty());
+}
@@ -18,3 +18,45 @@ TEST(codec_shared_stream, positive_test) {
 
     EXPECT_EQ(os.get(), in);
 }
+
+TEST(codec_shared_stream, systematic_test) {
+    using Vector = std::vector<uint8_t>;
+    using Stream = share::codec::istream<Vector>;
+
+    auto is = Stream(share::codec::token::get(share::codec::token::Type::FULL), Stream::Mode::SYSTEMATIC);
+    auto os = share::codec::ostream<Vector>();
+    auto in = Vector(1000, 1);
+
+    // lose the first frame, recovered from a repair frame
+    auto n = is.set(in, 100, 2);
+    is.pop();
+    for (--n; n; --n)
+        if (os.push(is.pop()) != 0)
+            break;
+
+    EXPECT_EQ(os.get(), in);
+}
+
+TEST(codec_shared_stream, span_test) {
+    using Vector = std::vector<uint8_t>;
+
+    auto gen = std::mt19937{7};
+    auto in  = Vector(5000);
+    std::generate(std::begin(in), std::end(in), [&gen]() { return uint8_t(gen()); });
+
+    // single buffer and scatter-gather list (empty and frame crossing buffers)
+    auto lists = std::vector<share::codec::buffers>{
+      {share::codec::span{in}},
+      {share::codec::span{in.data(), 1234},
+       share::codec::span{in.data() + 1234, 0},
+       share::codec::span{in.data() + 1234, 3766}},
+    };
+    for (auto& list : lists) {
+        auto is = share::codec::istream<Vector>();
+        auto os = share::codec::ostream<Vector>(200);
+        for (auto n = is.set(list, 100, 10); n; --n)
+            if (os.push(is.pop()) != 0)
+                break;
+        EXPECT_EQ(os.get(), in);
+    }
+}
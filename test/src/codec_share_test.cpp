@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <random>
+#include <thread>
 
 #include "decoder.hpp"
 #include "encoder.hpp"
+#include "helpers/copy.hpp"
 
 /// CodecEnvironmentParams
 struct CodecEnvironmentParams {
@@ -57,3 +59,336 @@ INSTANTIATE_TEST_SUITE_P(
     CodecEnvironmentParams{1000000, 50, 1, share::codec::token::Type::MESSAGE},
     CodecEnvironmentParams{1000000, 50, 5, share::codec::token::Type::STREAM},
     CodecEnvironmentParams{1000000, 50, 2, share::codec::token::Type::SPARSE}));
+
+/// Test incremental decoding (one frame per push)
+TEST_F(CodecEnvironment, incremental_test) {
+    auto input   = generate(1000, 50);
+    auto token   = share::codec::token::generate(share::codec::token::Type::SPARSE, 1);
+    auto encoder = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto decoder = share::codec::decoder<std::vector<uint8_t>>(input.size(), token);
+    for (auto& frame : encoder.pop(input.size() + 10)) {
+        decoder.push(std::move(frame));
+        if (decoder.full())
+            break;
+    }
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+/// Test deferred decoding (payload combined once)
+TEST_F(CodecEnvironment, deferred_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(1000, 50);
+    auto token    = share::codec::token::generate(share::codec::token::Type::MESSAGE, 1);
+    auto encoder  = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto decoder  = Decoder(input.size(), token, Decoder::Mode::DEFERRED);
+    for (auto& frame : encoder.pop(input.size() + 10)) {
+        decoder.push(std::move(frame));
+        if (decoder.full())
+            break;
+    }
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+/// Test sparse decoding (compressed rows, fill-in minimizing pivots)
+TEST_F(CodecEnvironment, sparse_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(1000, 100);
+    for (auto type : {share::codec::token::Type::SPARSE,
+                      share::codec::token::Type::STREAM,
+                      share::codec::token::Type::FULL}) {
+        auto token   = share::codec::token::generate(type, 3);
+        auto encoder = share::codec::encoder<std::vector<uint8_t>>(input, token);
+        auto decoder = Decoder(input.size(), token, Decoder::Mode::SPARSE);
+        auto count   = size_t{0};
+        for (auto& frame : encoder.pop(4 * input.size())) {
+            count += decoder.push(std::move(frame)) ? 1 : 0;
+            if (decoder.full())
+                break;
+        }
+        EXPECT_EQ(count, input.size());
+        EXPECT_TRUE(decoder.full());
+        EXPECT_EQ(decoder.pop(), input);
+        EXPECT_TRUE(decoder.empty());
+    }
+}
+
+/// Test binary decoder (token field 1, bit packed elimination)
+TEST_F(CodecEnvironment, binary_test) {
+    using Stamp   = share::codec::token::Stamp;
+    using Density = share::codec::token::Density;
+    auto input    = generate(1000, 130);
+    auto token    = std::make_shared<const Stamp>(256, Density{1, 127});
+    auto encoder  = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto decoder  = share::codec::decoder<std::vector<uint8_t>>(input.size(), token);
+    auto count    = size_t{0};
+    for (auto& frame : encoder.pop(4 * input.size())) {
+        count += decoder.push(std::move(frame)) ? 1 : 0;
+        if (decoder.full())
+            break;
+    }
+    EXPECT_EQ(count, input.size());
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+/// Test mixed decoder (binary and GF(2^8) fields, binary rows solved first at full rank)
+TEST_F(CodecEnvironment, mixed_decoder_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(1000, 70);
+    auto token    = share::codec::token::generate(share::codec::token::Type::STREAM, 2);
+    auto workers  = std::make_shared<share::codec::helpers::parallel>(2, 256, 0);
+    EXPECT_TRUE(std::any_of(std::begin(*token), std::end(*token), [](auto& density) {
+        return density.first == 1;
+    }));
+    for (auto parallel : {Decoder::Parallel{}, workers}) {
+        auto encoder = share::codec::encoder<std::vector<uint8_t>>(input, token);
+        auto decoder = Decoder(input.size(), token, Decoder::Mode::EAGER, parallel);
+        // systematic frames are binary rows, nothing is decoded before full rank
+        EXPECT_EQ(decoder.push(encoder.systematic(0, 10)), 10u);
+        EXPECT_TRUE(decoder.empty());
+        auto count = size_t{10};
+        for (auto& frame : encoder.pop(4 * input.size())) {
+            count += decoder.push(std::move(frame)) ? 1 : 0;
+            if (decoder.full())
+                break;
+        }
+        EXPECT_EQ(count, input.size());
+        EXPECT_TRUE(decoder.full());
+        EXPECT_EQ(decoder.pop(), input);
+    }
+}
+
+/// Test mixed solve (binary rows first, GF(2^8) rows on the columns left)
+TEST_F(CodecEnvironment, mixed_solve_test) {
+    using namespace share::codec;
+    auto input = generate(1000, 70);
+    for (auto seed : {1u, 2u, 3u}) {
+        auto token   = token::generate(token::Type::STREAM, seed);
+        auto encoder = share::codec::encoder<std::vector<uint8_t>>(input, token);
+        auto workers = helpers::parallel(2, 256, 0);
+        auto field   = std::vector<uint8_t>();
+        auto coef    = container<std::vector<uint8_t>>();
+        auto data    = container<std::vector<uint8_t>>();
+        for (auto& frame : encoder.pop(3 * input.size())) {
+            auto seed = uint32_t{0};
+            helpers::copy(std::prev(std::end(frame), sizeof(seed)), seed);
+            frame.resize(frame.size() - sizeof(seed));
+            auto row = std::vector<uint8_t>(input.size());
+            helpers::coefficients<std::minstd_rand0>(
+              seed, (*token)[uint8_t(seed)].first, (*token)[uint8_t(seed)].second, row);
+            field.push_back((*token)[uint8_t(seed)].first);
+            coef.push_back(std::move(row));
+            data.push_back(std::move(frame));
+        }
+        EXPECT_GT(std::count(std::begin(field), std::end(field), 1), 0);
+        EXPECT_EQ(helpers::solve(input.size(), field, coef, data, workers), input.size());
+        data.resize(input.size());
+        EXPECT_EQ(data, input);
+    }
+}
+
+/// Test organize (stable partition, binary rows first)
+TEST_F(CodecEnvironment, organize_test) {
+    using namespace share::codec;
+    auto field = std::vector<uint8_t>{3, 1, 255, 1, 7, 1};
+    auto coef  = container<std::vector<uint8_t>>();
+    auto data  = container<std::vector<uint8_t>>();
+    for (size_t i = 0; i < field.size(); ++i) {
+        coef.push_back(std::vector<uint8_t>(4, uint8_t(i)));
+        data.push_back(std::vector<uint8_t>(8, uint8_t(i)));
+    }
+    helpers::organize(field, coef, data);
+    EXPECT_EQ(field, (std::vector<uint8_t>{1, 1, 1, 3, 255, 7}));
+    auto order = std::vector<uint8_t>{1, 3, 5, 0, 2, 4};
+    for (size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(coef[i], std::vector<uint8_t>(4, order[i]));
+        EXPECT_EQ(data[i], std::vector<uint8_t>(8, order[i]));
+    }
+}
+
+/// Test innovative result (redundant payloads are dropped)
+TEST_F(CodecEnvironment, innovative_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(100, 20);
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto encoder  = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    for (auto mode : {Decoder::Mode::EAGER, Decoder::Mode::DEFERRED, Decoder::Mode::SPARSE}) {
+        auto decoder = Decoder(input.size(), token, mode);
+        auto coded   = encoder.pop(input.size() + 5);
+        // a copy of a received frame adds no rank
+        EXPECT_TRUE(decoder.push(coded.front()));
+        EXPECT_FALSE(decoder.push(coded.front()));
+        auto count = size_t{1};
+        for (size_t i = 1; i < coded.size(); ++i)
+            count += decoder.push(std::move(coded[i])) ? 1 : 0;
+        EXPECT_EQ(count, input.size());
+        EXPECT_TRUE(decoder.full());
+        // frames after full rank
+        EXPECT_EQ(decoder.push(encoder.pop(3)), 0u);
+        EXPECT_EQ(decoder.pop(), input);
+    }
+}
+
+/// Test parallel payload elimination (column stripes)
+TEST_F(CodecEnvironment, parallel_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(10000, 50);
+    auto token    = share::codec::token::generate(share::codec::token::Type::FULL, 1);
+    auto workers  = std::make_shared<share::codec::helpers::parallel>(4, 256, 0);
+    for (auto mode : {Decoder::Mode::EAGER, Decoder::Mode::DEFERRED}) {
+        auto encoder = share::codec::encoder<std::vector<uint8_t>>(input, token);
+        auto decoder = Decoder(input.size(), encoder.pop(input.size() + 2), token, mode, workers);
+        EXPECT_EQ(decoder.pop(), input);
+    }
+}
+
+/// Test parallel solve
+TEST_F(CodecEnvironment, parallel_solve_test) {
+    using namespace share::codec;
+    auto input   = generate(10000, 50);
+    auto token   = token::get(token::Type::FULL);
+    auto encoder = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto workers = helpers::parallel(4, 256, 0);
+    auto field   = std::vector<uint8_t>();
+    auto coef    = helpers::matrix(0, input.size());
+    auto data    = container<std::vector<uint8_t>>();
+    for (auto& frame : encoder.pop(input.size() + 2)) {
+        auto seed = uint32_t{0};
+        helpers::copy(std::prev(std::end(frame), sizeof(seed)), seed);
+        frame.resize(frame.size() - sizeof(seed));
+        auto row = std::vector<uint8_t>(input.size());
+        helpers::coefficients<std::minstd_rand0>(
+          seed, (*token)[uint8_t(seed)].first, (*token)[uint8_t(seed)].second, row);
+        field.push_back((*token)[uint8_t(seed)].first);
+        coef.push_back(std::move(row));
+        data.push_back(std::move(frame));
+    }
+    EXPECT_EQ(helpers::solve(input.size(), field, coef, data, workers), input.size());
+    data.resize(input.size());
+    EXPECT_EQ(data, input);
+}
+
+/// Test non owning (zero-copy) encoder frames
+TEST_F(CodecEnvironment, span_encoder_test) {
+    auto input   = generate(1000, 20);
+    auto buffer  = std::vector<uint8_t>{};
+    for (auto& frame : input)
+        buffer.insert(std::end(buffer), std::begin(frame), std::end(frame));
+    auto token   = share::codec::token::get(share::codec::token::Type::FULL);
+    auto encoder = share::codec::encoder<std::vector<uint8_t>>(input.size(), token);
+    // full frames are views, the partial last frame is copied
+    encoder.push(share::codec::span{buffer.data(), buffer.size() - 10}, input.front().size());
+    encoder.push(share::codec::span{input.back()});
+    EXPECT_EQ(encoder.size(), input.size() + 1);
+    EXPECT_THROW(encoder.push(share::codec::span{buffer.data(), 10}), std::range_error);
+
+    auto decoder = share::codec::decoder<std::vector<uint8_t>>(input.size() + 1, token);
+    decoder.push(encoder.pop(input.size() + 5));
+    EXPECT_TRUE(decoder.full());
+    auto output = decoder.pop();
+    std::fill(std::prev(std::end(input.back()), 10), std::end(input.back()), 0);
+    output.resize(input.size());
+    EXPECT_EQ(output, input);
+}
+
+/// Test systematic seeds range (0xFFFF is the recoded seed)
+TEST_F(CodecEnvironment, systematic_range_test) {
+    namespace seed = share::codec::seed;
+    EXPECT_EQ(seed::index(seed::systematic(0xFFFE)), 0xFFFEu);
+    EXPECT_THROW(seed::systematic(0xFFFF), std::out_of_range);
+    EXPECT_THROW(seed::systematic(0x10000), std::out_of_range);
+
+    auto buffer  = std::vector<uint8_t>(0x10000, 1);
+    auto encoder = share::codec::encoder<std::vector<uint8_t>>();
+    encoder.push(share::codec::span{buffer}, 1);
+    EXPECT_EQ(encoder.systematic(0xFFFE, 1).size(), 1u);
+    EXPECT_THROW(encoder.systematic(0xFFFE, 2), std::out_of_range);
+    EXPECT_TRUE(encoder.systematic(0x10000, 1).empty());
+}
+
+/// Test counter based generator (batch and single bytes match) on both sides
+TEST_F(CodecEnvironment, counter_generator_test) {
+    using Generator = share::codec::helpers::counter;
+    auto single     = Generator{1234};
+    auto batch      = Generator{1234};
+    auto bytes      = std::vector<uint8_t>(103);
+    batch.fill(bytes.data(), 3);
+    batch.fill(bytes.data() + 3, 100);
+    for (auto byte : bytes)
+        EXPECT_EQ(byte, single());
+
+    auto input   = generate(1000, 50);
+    auto token   = share::codec::token::generate(share::codec::token::Type::MESSAGE, 1);
+    auto encoder = share::codec::encoder<std::vector<uint8_t>, std::random_device, Generator>(
+      input, token);
+    auto decoder = share::codec::decoder<std::vector<uint8_t>, Generator>(input.size(), token);
+    decoder.push(encoder.pop(input.size() + 10));
+    EXPECT_TRUE(decoder.full());
+    EXPECT_EQ(decoder.pop(), input);
+}
+
+/// Test coefficient cache (repeated seeds)
+TEST_F(CodecEnvironment, coefficient_cache_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(1000, 20);
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto encoder  = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto cache    = std::make_shared<share::codec::helpers::cache>(64);
+    auto coded    = encoder.pop(input.size() + 2);
+    for (auto i = 0; i < 2; ++i) {
+        auto decoder = Decoder(input.size(), token);
+        decoder.cache(cache);
+        decoder.push(coded);
+        EXPECT_EQ(decoder.pop(), input);
+    }
+    EXPECT_GE(cache->misses(), input.size());
+    EXPECT_EQ(cache->hits(), cache->misses());
+}
+
+/// Test coefficient cache shared by decoders of different generators (same seeds)
+TEST_F(CodecEnvironment, coefficient_cache_generator_test) {
+    using Counter = share::codec::helpers::counter;
+    auto input    = generate(500, 20);
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto cache    = std::make_shared<share::codec::helpers::cache>(64);
+    auto seeds    = [](auto& encoder) {
+        auto seed = uint32_t{1};
+        return encoder.encode(30, [&seed]() { return seed += 0x9E3779B9u; });
+    };
+    auto minstd  = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto counter = share::codec::encoder<std::vector<uint8_t>, std::random_device, Counter>(
+      input, token);
+    auto first  = share::codec::decoder<std::vector<uint8_t>>(input.size(), token);
+    auto second = share::codec::decoder<std::vector<uint8_t>, Counter>(input.size(), token);
+    first.cache(cache);
+    second.cache(cache);
+    first.push(seeds(minstd));
+    second.push(seeds(counter));
+    EXPECT_EQ(first.pop(), input);
+    EXPECT_EQ(second.pop(), input);
+    EXPECT_EQ(cache->hits(), 0u);
+}
+
+/// Test concurrent and parallel encoding
+TEST_F(CodecEnvironment, concurrent_encoder_test) {
+    using Decoder = share::codec::decoder<std::vector<uint8_t>>;
+    auto input    = generate(10000, 20);
+    auto token    = share::codec::token::get(share::codec::token::Type::FULL);
+    auto workers  = share::codec::helpers::parallel(4, 256, 0);
+    auto encoder  = share::codec::encoder<std::vector<uint8_t>>(input, token);
+    auto coded    = std::vector<Decoder::Container>(4);
+    auto threads  = std::vector<std::thread>();
+    for (size_t i = 0; i < coded.size(); ++i)
+        threads.emplace_back([&, i]() {
+            coded[i] = (i % 2) ? encoder.pop(input.size() + 2, workers)
+                               : encoder.pop(input.size() + 2);
+        });
+    for (auto& thread : threads)
+        thread.join();
+    for (auto& code : coded) {
+        auto decoder = Decoder(input.size(), code, token);
+        EXPECT_EQ(decoder.pop(), input);
+    }
+}
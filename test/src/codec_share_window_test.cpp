@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "window.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+TEST(codec_shared_window, in_order_test) {
+    auto gen     = std::mt19937{11};
+    auto encoder = share::codec::window::encoder<Vector>(16, 64);
+    auto decoder = share::codec::window::decoder<Vector>(16, 64);
+    auto sources = std::vector<Vector>{};
+    auto output  = std::vector<Vector>{};
+    auto loss    = std::bernoulli_distribution{0.2};
+    for (uint32_t n = 0; n < 500; ++n) {
+        auto frame = Vector(64);
+        std::generate(std::begin(frame), std::end(frame), [&gen]() { return uint8_t(gen()); });
+        sources.push_back(frame);
+        auto index = encoder.push(std::move(frame));
+        // systematic frame and a repair frame every other frame, both over a lossy link
+        if (!loss(gen))
+            decoder.push(encoder.systematic(index));
+        if (n % 2 && !loss(gen))
+            decoder.push(encoder.pop());
+        while (decoder.ready())
+            output.push_back(decoder.pop());
+        encoder.ack(decoder.next());
+        EXPECT_LE(encoder.size(), 16u);
+        EXPECT_LE(decoder.pending(), 16u);
+    }
+    // in order, any frame given up is counted as lost
+    EXPECT_EQ(output.size() + decoder.lost(), decoder.next());
+    EXPECT_GT(output.size(), sources.size() * 9 / 10);
+    auto next = size_t{0};
+    for (auto& frame : output) {
+        while (next < sources.size() && sources[next] != frame)
+            ++next;
+        ASSERT_LT(next, sources.size());
+        ++next;
+    }
+}
+
+TEST(codec_shared_window, repair_test) {
+    auto gen     = std::mt19937{5};
+    auto encoder = share::codec::window::encoder<Vector>(8, 32);
+    auto decoder = share::codec::window::decoder<Vector>(8, 32);
+    auto sources = std::vector<Vector>{};
+    for (auto n = 0; n < 4; ++n) {
+        auto frame = Vector(32);
+        std::generate(std::begin(frame), std::end(frame), [&gen]() { return uint8_t(gen()); });
+        sources.push_back(frame);
+        encoder.push(std::move(frame));
+    }
+    // first frame lost, recovered from a combination
+    EXPECT_EQ(decoder.push(encoder.systematic(1)), 0u);
+    EXPECT_EQ(decoder.push(encoder.systematic(2)), 0u);
+    EXPECT_EQ(decoder.push(encoder.systematic(3)), 0u);
+    EXPECT_EQ(decoder.push(encoder.pop()), 4u);
+    for (auto& frame : sources)
+        EXPECT_EQ(decoder.pop(), frame);
+    EXPECT_EQ(decoder.next(), 4u);
+}
+
+TEST(codec_shared_window, malformed_test) {
+    auto encoder = share::codec::window::encoder<Vector>(8, 100);
+    auto decoder = share::codec::window::decoder<Vector>(8, 100);
+    for (uint8_t n = 0; n < 4; ++n)
+        encoder.push(Vector(100, n));
+    // truncated first frame (the payload length is not taken from it)
+    auto frame = encoder.systematic(1);
+    frame.erase(std::begin(frame), std::next(std::begin(frame), 50));
+    EXPECT_EQ(decoder.push(std::move(frame)), 0u);
+    EXPECT_EQ(decoder.pending(), 0u);
+    decoder.push(encoder.systematic(0));
+    EXPECT_EQ(decoder.ready(), 1u);
+    // truncated payload (another length than the payload length)
+    frame = encoder.pop();
+    frame.erase(std::begin(frame), std::next(std::begin(frame), 50));
+    EXPECT_EQ(decoder.push(std::move(frame)), 1u);
+    EXPECT_EQ(decoder.pending(), 0u);
+    // count beyond the span
+    frame = encoder.pop();
+    frame[100 + sizeof(uint32_t)] = 0xFF;
+    frame[101 + sizeof(uint32_t)] = 0xFF;
+    EXPECT_EQ(decoder.push(std::move(frame)), 1u);
+    EXPECT_EQ(decoder.pending(), 0u);
+    // well formed frames still decode
+    for (uint32_t n = 1; n < 4; ++n)
+        decoder.push(encoder.systematic(n));
+    EXPECT_EQ(decoder.ready(), 4u);
+    for (uint8_t n = 0; n < 4; ++n)
+        EXPECT_EQ(decoder.pop(), Vector(100, n));
+}
+
+TEST(codec_shared_window, length_test) {
+    auto encoder = share::codec::window::encoder<Vector>(8, 16);
+    encoder.push(Vector(16, 1));
+    // frames of another length would be read past their end by the combinations
+    EXPECT_THROW(encoder.push(Vector(4096, 2)), std::range_error);
+    EXPECT_THROW(encoder.push(Vector(8, 2)), std::range_error);
+    EXPECT_EQ(encoder.size(), 1u);
+    EXPECT_EQ(encoder.pop().size(), 16u + share::codec::window::HEADER_SIZE);
+}
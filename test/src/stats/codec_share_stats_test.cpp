@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "decoder.hpp"
+#include "encoder.hpp"
+
+#include "codec_share_fixture.hpp"
+
+using Vector = std::vector<uint8_t>;
+using share::codec::helpers::stats;
+
+TEST(codec_shared_stats, encoder_test) {
+    auto data    = generate(100, 20, 1);
+    auto encoder = share::codec::encoder<Vector>(data);
+    auto coded   = encoder.pop(30);
+    auto& s      = encoder.stats();
+    EXPECT_EQ(s.get(stats::FRAMES), 30u);
+    EXPECT_EQ(s.get(stats::ROWOPS), 30u * 20u);
+    EXPECT_EQ(s.get(stats::BYTES), 30u * 20u * 100u);
+    EXPECT_EQ(s.get(stats::ALLOCATIONS), 30u);
+    EXPECT_GT(s.time(stats::COEFFICIENTS), 0u);
+    EXPECT_GT(s.time(stats::PAYLOAD), 0u);
+    // warm pool
+    encoder.recycle(std::move(coded));
+    s.reset();
+    coded = encoder.pop(30);
+    EXPECT_EQ(s.get(stats::ALLOCATIONS), 0u);
+}
+
+TEST(codec_shared_stats, decoder_test) {
+    using Mode = share::codec::decoder<Vector>::Mode;
+    auto data  = generate(100, 20, 2);
+    for (auto mode : {Mode::EAGER, Mode::DEFERRED}) {
+        auto encoder = share::codec::encoder<Vector>(data);
+        auto decoder = share::codec::decoder<Vector>(
+          20, share::codec::token::get(share::codec::token::Type::FULL), mode);
+        auto coded   = encoder.pop(25);
+        // a copy of a frame is not innovative
+        auto copy = coded.front();
+        decoder.push(std::move(copy));
+        for (auto& frame : coded)
+            decoder.push(std::move(frame));
+        auto& s = decoder.stats();
+        EXPECT_EQ(s.get(stats::FRAMES), 26u);
+        EXPECT_EQ(s.get(stats::INNOVATIVE), 20u);
+        EXPECT_EQ(s.get(stats::REDUNDANT), 6u);
+        EXPECT_EQ(s.get(stats::RANK), 20u);
+        EXPECT_GT(s.get(stats::ROWOPS), 0u);
+        EXPECT_GT(s.get(stats::BYTES), 0u);
+        EXPECT_GT(s.time(stats::FORWARD), 0u);
+        EXPECT_GT(s.time(stats::PAYLOAD), 0u);
+        EXPECT_EQ(decoder.pop(), data);
+    }
+}
+
+TEST(codec_shared_stats, trace_test) {
+    auto trace   = std::make_shared<share::codec::helpers::trace>();
+    auto encoder = share::codec::encoder<Vector>(generate(64, 8, 3));
+    auto decoder = share::codec::decoder<Vector>(8);
+    decoder.stats().trace(trace);
+    for (auto& frame : encoder.pop(8))
+        decoder.push(std::move(frame));
+    EXPECT_GT(trace->size(), 0u);
+    auto json = trace->json();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"forward\""), std::string::npos);
+    EXPECT_NE(decoder.stats().json().find("\"innovative\":"), std::string::npos);
+}
+
+TEST(codec_shared_stats, solve_test) {
+    using namespace share::codec;
+    auto s     = stats();
+    auto bind  = stats::bind(&s);
+    auto token = token::get(token::Type::FULL);
+    auto coded = encoder<Vector>(generate(32, 10, 4), token).pop(10);
+    auto field = Vector();
+    auto coef  = container<Vector>();
+    auto data  = container<Vector>();
+    for (auto& frame : coded) {
+        auto seed = uint32_t{0};
+        helpers::copy(std::prev(std::end(frame), sizeof(seed)), seed);
+        frame.resize(32);
+        auto row = Vector(10);
+        helpers::coefficients<std::minstd_rand0>(
+          seed, (*token)[uint8_t(seed)].first, (*token)[uint8_t(seed)].second, row);
+        field.push_back((*token)[uint8_t(seed)].first);
+        coef.push_back(std::move(row));
+        data.push_back(std::move(frame));
+    }
+    auto rank = helpers::solve(10, field, coef, data);
+    EXPECT_EQ(s.get(stats::RANK), rank);
+    EXPECT_GT(s.get(stats::ROWOPS), 0u);
+    EXPECT_GT(s.time(stats::BACKWARD), 0u);
+}
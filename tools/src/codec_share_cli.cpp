@@ -0,0 +1,347 @@
+/// ===============================================================================================
+/// @file      : codec_share_cli.cpp                                       |
+/// @copyright : 2020 LCMonteiro                                     __|   __ \    _` |   __|  _ \.
+///                                                                 \__ \  | | |  (   |  |     __/
+/// @author    : Luis Monteiro                                      ____/ _| |_| \__,_| _|   \___|
+/// ===============================================================================================
+///   codec-share-cli encode [options] <input> <output|->
+///   codec-share-cli decode [options] <input|-> <output>
+///
+///   stream layout (little endian):
+///     [descriptor][size:4][frame][size:4][frame]...
+///     descriptor: [magic:4][length:8][k:4][framesize:4][token:1][key:8]
+/// ===============================================================================================
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "object.hpp"
+
+using Vector = std::vector<uint8_t>;
+
+namespace {
+using namespace share::codec;
+
+/// stream magic
+constexpr uint32_t MAGIC = 0x31485343; // "CSH1"
+/// descriptor size
+constexpr size_t DESCRIPTOR_SIZE = 4 + 8 + 4 + 4 + 1 + 8;
+
+/// options
+struct options {
+    std::string input;
+    std::string output;
+    token::Type token  = token::Type::FULL;
+    uint64_t key       = 0;
+    size_t framesize   = 1024;
+    size_t k           = 64;
+    size_t redundancy  = 4;
+    size_t threads     = std::thread::hardware_concurrency();
+    size_t batch       = 0;
+};
+
+/// descriptor
+struct descriptor {
+    object::layout layout;
+    token::Type token;
+    uint64_t key;
+};
+
+/// usage
+int usage() {
+    std::fprintf(
+      stderr,
+      "usage: codec-share-cli encode [options] <input> <output|->\n"
+      "       codec-share-cli decode [options] <input|-> <output>\n"
+      "options:\n"
+      "  --token <full|sparse|stream|message>  coefficient token type  (encode, full)\n"
+      "  --key <n>                             token generation key    (encode, default token)\n"
+      "  --frame <bytes>                       frame size              (encode, 1024)\n"
+      "  --generation <frames>                 generation size         (encode, 64)\n"
+      "  --redundancy <frames>                 extra frames per gen.   (encode, 4)\n"
+      "  --threads <n>                         worker threads          (cores)\n"
+      "  --batch <generations>                 generations per batch   (threads)\n");
+    return 2;
+}
+
+/// parse
+/// @return false on bad arguments
+bool parse(int argc, char** argv, options& opt) {
+    static const auto TOKENS = std::map<std::string, token::Type>{
+      {"full", token::Type::FULL},
+      {"sparse", token::Type::SPARSE},
+      {"stream", token::Type::STREAM},
+      {"message", token::Type::MESSAGE}};
+    auto args = std::vector<std::string>();
+    for (int i = 2; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        if (arg.size() < 3 || arg.compare(0, 2, "--") != 0) {
+            args.push_back(arg);
+            continue;
+        }
+        if (++i >= argc)
+            return false;
+        auto value = std::string(argv[i]);
+        try {
+            if (arg == "--token") {
+                if (!TOKENS.count(value))
+                    return false;
+                opt.token = TOKENS.at(value);
+            } else if (arg == "--key")
+                opt.key = std::stoull(value);
+            else if (arg == "--frame")
+                opt.framesize = std::stoul(value);
+            else if (arg == "--generation")
+                opt.k = std::stoul(value);
+            else if (arg == "--redundancy")
+                opt.redundancy = std::stoul(value);
+            else if (arg == "--threads")
+                opt.threads = std::stoul(value);
+            else if (arg == "--batch")
+                opt.batch = std::stoul(value);
+            else
+                return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    if (args.size() != 2 || opt.framesize == 0 || opt.k == 0 || opt.k > 0xFFFF)
+        return false;
+    opt.input   = args[0];
+    opt.output  = args[1];
+    opt.threads = std::max(opt.threads, size_t{1});
+    opt.batch   = opt.batch ? opt.batch : opt.threads;
+    return true;
+}
+
+/// stamp
+/// @brief default stamp of the type or a generated one (key)
+token::shared::Stamp stamp(token::Type type, uint64_t key) {
+    if (key == 0 && token::DEFAULT.count(type))
+        return token::get(type);
+    return token::generate(type, key);
+}
+
+/// write all
+bool write(FILE* out, const uint8_t* data, size_t size) {
+    return std::fwrite(data, 1, size, out) == size;
+}
+
+/// read all
+bool read(FILE* in, uint8_t* data, size_t size) {
+    return std::fread(data, 1, size, in) == size;
+}
+
+/// serialize / unserialize the descriptor
+Vector serialize(const descriptor& d) {
+    auto out = Vector(DESCRIPTOR_SIZE);
+    auto it  = std::begin(out);
+    it       = helpers::copy(MAGIC, it);
+    it       = helpers::copy(uint32_t(d.layout.length), it);
+    it       = helpers::copy(uint32_t(uint64_t(d.layout.length) >> 32), it);
+    it       = helpers::copy(uint32_t(d.layout.k), it);
+    it       = helpers::copy(uint32_t(d.layout.framesize), it);
+    it       = helpers::copy(uint8_t(d.token), it);
+    it       = helpers::copy(uint32_t(d.key), it);
+    it       = helpers::copy(uint32_t(d.key >> 32), it);
+    return out;
+}
+bool unserialize(const Vector& in, descriptor& d) {
+    auto magic = uint32_t{0}, lo = uint32_t{0}, hi = uint32_t{0};
+    auto k = uint32_t{0}, framesize = uint32_t{0}, klo = uint32_t{0}, khi = uint32_t{0};
+    auto type = uint8_t{0};
+    auto it   = std::begin(in);
+    it        = helpers::copy(it, magic);
+    it        = helpers::copy(it, lo);
+    it        = helpers::copy(it, hi);
+    it        = helpers::copy(it, k);
+    it        = helpers::copy(it, framesize);
+    it        = helpers::copy(it, type);
+    it        = helpers::copy(it, klo);
+    it        = helpers::copy(it, khi);
+    d.layout  = {size_t((uint64_t(hi) << 32) | lo), k, framesize};
+    d.token   = token::Type(type);
+    d.key     = (uint64_t(khi) << 32) | klo;
+    return magic == MAGIC && k != 0 && k <= 0xFFFF && framesize != 0
+           && type <= uint8_t(token::Type::FULL);
+}
+
+/// peak resident set (MB)
+double peak() {
+    auto usage = rusage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return double(usage.ru_maxrss) / 1024;
+}
+
+/// report
+void report(const char* what, size_t bytes, std::chrono::steady_clock::time_point start) {
+    auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(
+      stderr,
+      "%s: %zu bytes in %.3f s (%.1f MB/s), peak rss %.1f MB\n",
+      what,
+      bytes,
+      secs,
+      secs > 0 ? double(bytes) / secs / 1e6 : 0.0,
+      peak());
+}
+
+/// encode
+/// @brief the input is memory mapped, generations are coded by batches and the consumed
+///        input pages are dropped, so the resident memory is bounded by a batch
+int encode(const options& opt) {
+    auto start = std::chrono::steady_clock::now();
+    auto fd    = ::open(opt.input.c_str(), O_RDONLY);
+    struct stat st {};
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::perror(opt.input.c_str());
+        return 1;
+    }
+    auto length = size_t(st.st_size);
+    auto base   = static_cast<uint8_t*>(nullptr);
+    if (length) {
+        auto map = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            std::perror("mmap");
+            return 1;
+        }
+        base = static_cast<uint8_t*>(map);
+        ::madvise(base, length, MADV_SEQUENTIAL);
+    }
+    auto out = opt.output == "-" ? stdout : std::fopen(opt.output.c_str(), "wb");
+    if (!out) {
+        std::perror(opt.output.c_str());
+        return 1;
+    }
+    // coder
+    auto desc    = descriptor{{length, opt.k, opt.framesize}, opt.token, opt.key};
+    auto workers = std::make_shared<helpers::parallel>(opt.threads);
+    auto coder   = object::encoder<Vector>(
+      span{base, length}, desc.layout, stamp(opt.token, opt.key), workers);
+    auto head = serialize(desc);
+    auto ok   = write(out, head.data(), head.size());
+    // batches
+    auto size  = Vector(sizeof(uint32_t));
+    auto bytes = head.size();
+    auto page  = size_t(::sysconf(_SC_PAGESIZE));
+    for (size_t g = 0; ok && g < coder.generations(); g += opt.batch) {
+        for (auto& frames : coder.pop(g, opt.batch, opt.redundancy)) {
+            for (auto& frame : frames) {
+                helpers::copy(uint32_t(frame.size()), std::begin(size));
+                ok = ok && write(out, size.data(), size.size());
+                ok = ok && write(out, frame.data(), frame.size());
+                bytes += size.size() + frame.size();
+            }
+        }
+        // drop the consumed pages
+        auto end = std::min(length, desc.layout.offset(g + opt.batch)) / page * page;
+        if (end)
+            ::madvise(base, end, MADV_DONTNEED);
+    }
+    ok = std::fflush(out) == 0 && ok;
+    if (!ok)
+        std::perror(opt.output.c_str());
+    if (out != stdout)
+        std::fclose(out);
+    if (length)
+        ::munmap(base, length);
+    ::close(fd);
+    report("encode", length, start);
+    std::fprintf(stderr, "encode: %zu generations, %zu bytes written\n", coder.generations(), bytes);
+    return ok ? 0 : 1;
+}
+
+/// decode
+/// @brief frames are read sequentially (file or pipe) and pushed by batches, decoded
+///        generations are written at their offset of the output file
+int decode(const options& opt) {
+    auto start = std::chrono::steady_clock::now();
+    auto in    = opt.input == "-" ? stdin : std::fopen(opt.input.c_str(), "rb");
+    if (!in) {
+        std::perror(opt.input.c_str());
+        return 1;
+    }
+    auto head = Vector(DESCRIPTOR_SIZE);
+    auto desc = descriptor{};
+    if (!read(in, head.data(), head.size()) || !unserialize(head, desc)) {
+        std::fprintf(stderr, "%s: not a codec-share stream\n", opt.input.c_str());
+        return 1;
+    }
+    auto fd = ::open(opt.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ::ftruncate(fd, off_t(desc.layout.length)) != 0) {
+        std::perror(opt.output.c_str());
+        return 1;
+    }
+    // decoder
+    auto failed  = std::atomic<bool>{false};
+    auto sink    = [fd, &failed](size_t offset, const uint8_t* data, size_t size) {
+        if (::pwrite(fd, data, size, off_t(offset)) != ssize_t(size))
+            failed = true;
+    };
+    auto workers = std::make_shared<helpers::parallel>(opt.threads);
+    auto coder   = object::decoder<Vector>(
+      desc.layout, sink, stamp(desc.token, desc.key), workers);
+    // batches
+    auto limit  = opt.batch * desc.layout.k;
+    auto frames = object::decoder<Vector>::Container();
+    auto size   = Vector(sizeof(uint32_t));
+    auto length = uint32_t{0};
+    while (!coder.full() && read(in, size.data(), size.size())) {
+        helpers::copy(std::begin(size), length);
+        if (length > desc.layout.framesize + header::SIZE) {
+            std::fprintf(stderr, "%s: corrupted stream\n", opt.input.c_str());
+            break;
+        }
+        auto frame = Vector(length);
+        if (!read(in, frame.data(), frame.size()))
+            break;
+        frames.push_back(std::move(frame));
+        if (frames.size() >= limit) {
+            coder.push(std::move(frames));
+            frames = {};
+        }
+    }
+    coder.push(std::move(frames));
+    if (in != stdin)
+        std::fclose(in);
+    ::close(fd);
+    report("decode", desc.layout.length, start);
+    if (failed) {
+        std::perror(opt.output.c_str());
+        return 1;
+    }
+    if (!coder.full()) {
+        std::fprintf(
+          stderr,
+          "decode: %zu of %zu generations decoded\n",
+          coder.decoded(),
+          desc.layout.generations());
+        return 1;
+    }
+    return 0;
+}
+} // namespace
+
+/// main
+int main(int argc, char** argv) {
+    auto opt = options{};
+    if (argc < 2 || !parse(argc, argv, opt))
+        return usage();
+    auto cmd = std::string(argv[1]);
+    if (cmd == "encode")
+        return encode(opt);
+    if (cmd == "decode")
+        return decode(opt);
+    return usage();
+}